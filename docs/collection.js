@@ -268,7 +268,19 @@ class Collection {
      *   The callback function is called with two arguments:
      *   - `collection`: the collection instance that changed,
      *   - `changes`: a dictionary with keys `insertions`, `modifications` and `deletions`,
-     *      each containing a list of indices that were inserted, updated or deleted respectively.
+     *      each containing a list of indices that were inserted, updated or deleted respectively,
+     *      and `moves`, containing a `{from, to}` pair for each object that was moved.
+     * @param {Object} [options] - Options controlling how changes are reported:
+     *   - `ranges`: if `true`, `insertions`, `modifications` and `deletions` contain
+     *     `[start, end)` pairs of indices instead of one entry per index.
+     *   - `throttleMs`: call the callback at most once per this many milliseconds. Changes that
+     *     occur in between are merged into a single change set.
+     *   - `maxPerSecond`: call the callback at most this many times per second, merging changes
+     *     like `throttleMs`.
+     *   - `debounceMs`: wait until no changes have occurred for this many milliseconds and then
+     *     call the callback once with all changes merged. May not be combined with throttling.
+     * @returns {number} A token identifying this registration, which can be passed to
+     *   {@link Collection#removeListener removeListener} to remove just this listener.
      * @throws {Error} If `callback` is not a function.
      * @example
      * wines.addListener((collection, changes) => {
@@ -279,13 +291,14 @@ class Collection {
      *  console.log(`new size of collection: ${collection.length}`);
      * });
      */
-    addListener(callback) {}
+    addListener(callback, options) {}
 
     /**
      * Remove the listener `callback` from the collection instance.
-     * @param {function(collection, changes)} callback - Callback function that was previously
- *       added as a listener through the {@link Collection#addListener addListener} method.
-     * @throws {Error} If `callback` is not a function.
+     * @param {function(collection, changes)|number} callback - Callback function that was previously
+ *       added as a listener through the {@link Collection#addListener addListener} method, or the
+     *   token returned by that call, which removes only that registration.
+     * @throws {Error} If `callback` is neither a function nor a number.
      */
     removeListener(callback) {}
 
@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2016 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A migration in progress, passed as the third argument to the `migration` function of a
+ * {@link Realm~Configuration Configuration}. Its methods change whole columns natively, which
+ * is much faster than changing the objects of the new Realm one at a time. Values are read from
+ * the Realm before the migration and written to the migrated Realm, matching objects by their
+ * position, so they should be called before objects are created or deleted.
+ *
+ * The migration can not be used after the `migration` function has returned.
+ * @memberof Realm
+ * @since 1.3.0
+ */
+class Migration {
+    /**
+     * Rename a property, keeping its values. The new property must have the same type as the
+     * old one, and the old property must not be in the new schema.
+     * @param {string} type - The name of the object type.
+     * @param {string} oldName - The name of the property in the old schema.
+     * @param {string} newName - The name of the property in the new schema.
+     */
+    renameProperty(type, oldName, newName) {}
+
+    /**
+     * Fill a property whose type has changed with the values it had in the old Realm, converted
+     * to the new type. The supported conversions are:
+     *   - to `"int"`, `"float"` and `"double"`: from any of these, from `"bool"` values as 0 or 1,
+     *     from `"date"` values as milliseconds since the epoch, and from strings which contain
+     *     nothing but a number.
+     *   - to `"bool"`: from `"int"` values, where anything but 0 is `true`, and from the strings
+     *     `"true"` and `"false"`.
+     *   - to `"date"`: from `"int"`, `"float"` and `"double"` values as milliseconds since the epoch.
+     *   - to `"string"`: from numbers, `"bool"` values, and `"date"` values as ISO 8601 strings.
+     *
+     * Any other conversion, such as from `"double"` to `"bool"` or from `"string"` to `"date"`,
+     * throws.
+     * @param {string} type - The name of the object type.
+     * @param {string} property - The name of the property.
+     * @param {Realm~PropertyType} fromType - The type of the property in the old schema.
+     * @param {Realm~PropertyType} toType - The type of the property in the new schema.
+     * @throws {Error} If the types do not match the schemas, or a value can not be converted.
+     */
+    convertColumn(type, property, fromType, toType) {}
+
+    /**
+     * Set a property of all objects of the new Realm to the values of another property of the
+     * same type in the old Realm.
+     * @param {string} type - The name of the object type.
+     * @param {string} fromProperty - The name of the property in the old schema.
+     * @param {string} toProperty - The name of the property in the new schema.
+     */
+    copyColumn(type, fromProperty, toProperty) {}
+
+    /**
+     * Set a property of all objects of the given type to the same value.
+     * @param {string} type - The name of the object type.
+     * @param {string} property - The name of the property in the new schema.
+     * @param {*} value - The value to set, or `null` for optional properties.
+     */
+    fillDefault(type, property, value) {}
+}
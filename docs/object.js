@@ -29,4 +29,35 @@ class Object {
      * @since 0.12.0
      */
     isValid() {}
+
+    /**
+     * Add a listener `callback` which will be called when this object changes or is deleted.
+     * @param {function(object, changes)} callback - A function to be called when changes occur.
+     *   The callback function is called with two arguments:
+     *   - `object`: the object that changed,
+     *   - `changes`: a dictionary with the keys `deleted`, which is `true` if the object was
+     *     deleted, and `changedProperties`, containing the names of the properties that were
+     *     modified.
+     * @returns {number} A token identifying this registration, which can be passed to
+     *   {@link Realm.Object#removeListener removeListener}.
+     * @throws {Error} If `callback` is not a function or the object is no longer valid.
+     * @since 1.3.0
+     */
+    addListener(callback) {}
+
+    /**
+     * Remove the listener `callback` from this object.
+     * @param {function(object, changes)|number} callback - Callback function that was previously
+     *   added as a listener through the {@link Realm.Object#addListener addListener} method, or
+     *   the token returned by that call.
+     * @throws {Error} If `callback` is neither a function nor a number.
+     * @since 1.3.0
+     */
+    removeListener(callback) {}
+
+    /**
+     * Remove all listeners from this object.
+     * @since 1.3.0
+     */
+    removeAllListeners() {}
 }
@@ -0,0 +1,76 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2016 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Keeps instances of a Realm open for reuse, for code which opens the same Realm over and over,
+ * like a server opening a Realm for every request. Every instance is separate, so an acquired
+ * Realm keeps seeing the version it was acquired at until it is released, while other
+ * instances move on. Releasing a Realm makes it drop that version.
+ *
+ * Not supported while debugging in Chrome.
+ * @memberof Realm
+ * @since 1.3.0
+ */
+class Pool {
+    /**
+     * Create a pool and open its first Realm, which creates or migrates the file.
+     * @param {Object} options
+     * @param {Realm~Configuration|string} [options.config] - The configuration of the Realms,
+     *   which may not use `shouldCompactOnLaunch` or `upgradeProgress`.
+     * @param {number} [options.max=16] - The number of released Realms kept open for reuse.
+     *   Realms released while that many are kept open are closed.
+     * @throws {Error} If the configuration is invalid or the Realm can not be opened.
+     */
+    constructor(options) {}
+
+    /**
+     * Counters of the Realms opened and reused by this pool, with the following properties:
+     *   - `hits` - The number of times a kept Realm was reused.
+     *   - `misses` - The number of Realms opened, including the first one.
+     *   - `openSeconds` and `averageOpenSeconds` - The total and average time spent opening them.
+     *   - `idle` - The number of released Realms kept open.
+     *   - `acquired` - The number of Realms acquired and not released yet. Each of them may keep
+     *     a different version of the file alive.
+     * @type {Object}
+     * @readonly
+     */
+    get metrics() {}
+
+    /**
+     * Get a Realm from the pool, refreshed to the latest version, or open a new one if no
+     * released Realm is kept open. Pooled Realms do not refresh automatically and only move to
+     * a newer version when acquired, so `"change"` listeners and collection and object
+     * listeners added to them are never called.
+     * @returns {Realm}
+     * @throws {Error} If the pool has been closed.
+     */
+    acquire() {}
+
+    /**
+     * Give back a Realm acquired from this pool. It must not be in a write transaction, and
+     * must not be used until it is acquired again.
+     * @param {Realm} realm - A Realm returned by {@link Realm.Pool#acquire acquire()}.
+     * @throws {Error} If the Realm was not acquired from this pool or is in a write transaction.
+     */
+    release(realm) {}
+
+    /**
+     * Close the Realms kept open by the pool. Realms still acquired are closed once released.
+     */
+    close() {}
+}
@@ -39,6 +39,32 @@ class Realm {
      */
     get readOnly() {}
 
+    /**
+     * Indicates if this Realm is kept in memory only.
+     * @type {boolean}
+     * @readonly
+     * @since 1.3.0
+     */
+    get inMemory() {}
+
+    /**
+     * The `groupCommitMs` of the {@link Realm~Configuration Configuration} this Realm was
+     * opened with, or `0` if group commits are disabled. Other Realm objects for the same file keep their own settings.
+     * @type {number}
+     * @readonly
+     * @since 1.3.0
+     */
+    get groupCommitMs() {}
+
+    /**
+     * The `groupCommitMax` of the {@link Realm~Configuration Configuration} this Realm was
+     * opened with, or `0` if there is no limit. Other Realm objects for the same file keep their own settings.
+     * @type {number}
+     * @readonly
+     * @since 1.3.0
+     */
+    get groupCommitMax() {}
+
     /**
      * A normalized representation of the schema provided in the
      * {@link Realm~Configuration Configuration} when this Realm was constructed.
@@ -104,6 +130,26 @@ class Realm {
      */
     deleteAll() {}
 
+    /**
+     * Delete all objects of the given types, or of all types, by clearing their tables at once
+     * instead of deleting objects one at a time. This can only be called from the callback of
+     * {@link Realm#write write()}. Once its transaction has been committed, `"reset"` listeners
+     * of this Realm are called instead of a notification per deleted object. Other instances of
+     * the Realm, including those in other processes, do not receive `"reset"`, only their
+     * collection listeners are told that the objects were deleted.
+     *
+     * The space used by the deleted objects is reused by later writes. With `compact`, the
+     * file is also compacted after the commit, which only succeeds if no other instance of the
+     * Realm is open.
+     * @param {Object} [options]
+     * @param {Realm~ObjectType[]} [options.types] - The types of objects to delete.
+     * @param {boolean} [options.compact=false] - Whether to compact the file after the commit.
+     * @throws {Error} If not called from the callback of {@link Realm#write write()}, which
+     *   includes migrations.
+     * @since 1.3.0
+     */
+    truncate(options) {}
+
     /**
      * Returns all objects of the given `type` in the Realm.
      * @param {Realm~ObjectType} type - The type of Realm objects to retrieve.
@@ -112,6 +158,17 @@ class Realm {
      */
     objects(type) {}
 
+    /**
+     * Returns all objects of the given `type` in the Realm, with the query evaluated on a
+     * background thread.
+     * @param {Realm~ObjectType} type - The type of Realm objects to retrieve.
+     * @throws {Error} If type passed into this method is invalid.
+     * @returns {Promise<Realm.Results>} resolved once the results are ready to be accessed.
+     * @see {@link Realm.Results#evaluateAsync evaluateAsync()}
+     * @since 1.3.0
+     */
+    objectsAsync(type) {}
+
     /**
      * Searches for a Realm object by its primary key.
      * @param {Realm~ObjectType} type - The type of Realm object to search for.
@@ -125,8 +182,12 @@ class Realm {
 
     /**
      * Add a listener `callback` for the specified event `name`.
-     * @param {string} name - The name of event that should cause the callback to be called.
-     *   _Currently, only the "change" event supported_.
+     * @param {string} name - The name of event that should cause the callback to be called:
+     *   `"change"` after the Realm has been refreshed to a new version, `"beforenotify"` before
+     *   collection and object listeners are notified of such a refresh, `"schema"` when the
+     *   schema of the Realm was changed by another process, or `"reset"` after a write
+     *   transaction of this instance which called {@link Realm#truncate truncate()} has been
+     *   committed.
      * @param {function(Realm, string)} callback - Function to be called when the event occurs.
      *   Each callback will only be called once per event, regardless of the number of times
      *   it was added.
@@ -136,8 +197,7 @@ class Realm {
 
    /**
     * Remove the listener `callback` for the specfied event `name`.
-    * @param {string} name - The event name.
-    *   _Currently, only the "change" event supported_.
+    * @param {string} name - The event name (`"change"`, `"beforenotify"`, `"schema"` or `"reset"`).
     * @param {function(Realm, string)} callback - Function that was previously added as a
     *   listener for this event through the {@link Realm#addListener addListener} method.
     * @throws {Error} If an invalid event `name` is supplied, or if `callback` is not a function.
@@ -146,17 +206,132 @@ class Realm {
 
    /**
     * Remove all event listeners (restricted to the event `name`, if provided).
-    * @param {string} [name] - The name of the event whose listeners should be removed.
-    *   _Currently, only the "change" event supported_.
+    * @param {string} [name] - The name of the event whose listeners should be removed
+    *   (`"change"`, `"beforenotify"`, `"schema"` or `"reset"`).
     * @throws {Error} When invalid event `name` is supplied
     */
     removeAllListeners(name) {}
 
+   /**
+    * Get latency statistics of the notifications delivered to this Realm. Each of the
+    * `commitToNotify`, `notify` and `callback` properties holds the `count` of samples taken
+    * and the `p50` and `p99` percentiles in milliseconds of the most recent samples:
+    *   - `commitToNotify`: from a write transaction committed in this process to the start of
+    *     the notification run delivering it. Commits by other processes are not measured.
+    *   - `notify`: from the start of a notification run until the `"change"` listeners
+    *     have been called.
+    *   - `callback`: the time spent in each listener callback, including those of
+    *     collections and objects.
+    * @returns {Object}
+    * @since 1.3.0
+    */
+    getNotificationStats() {}
+
    /**
     * Synchronously call the provided `callback` inside a write transaction.
     * @param {function()} callback
     */
     write(callback) {}
+
+   /**
+    * Call the provided `callback` inside the current write transaction, undoing the changes it
+    * made if it throws. The exception is then rethrown, and can be caught to continue the write
+    * transaction without those changes. Savepoints may be nested.
+    *
+    * Creating objects, updating them with {@link Realm#create create()}, setting properties
+    * other than lists and deleting objects created within the savepoint can be undone. Changes
+    * which can not be undone throw an error within the savepoint before anything is changed:
+    * changing lists, deleting objects which existed before the savepoint or all objects of a
+    * collection, and updating linked objects by their primary key. The write transaction is
+    * never cancelled by a savepoint.
+    * @param {function()} callback
+    * @returns {*} The value returned by `callback`.
+    * @throws {Error} If called outside of a write transaction.
+    * @since 1.3.0
+    */
+    savepoint(callback) {}
+
+   /**
+    * Queue the provided `callback` for the next group commit of this Realm, which was opened
+    * with `groupCommitMs`. The blocks queued within `groupCommitMs` of each other, or until
+    * `groupCommitMax` of them have been queued, are called together within a single write
+    * transaction. The transaction is committed on the JS thread, just like with
+    * {@link Realm#write write()}.
+    *
+    * The returned promise is resolved with the value returned by `callback` once the
+    * transaction has been committed. If `callback` throws, only its own promise is rejected
+    * and the other blocks of the group are called again in a new transaction, so they should
+    * not have side effects outside the Realm.
+    * @param {function()} callback
+    * @returns {Promise<*>}
+    * @throws {Error} If the Realm was not opened with `groupCommitMs`.
+    * @since 1.3.0
+    */
+    queueWrite(callback) {}
+
+   /**
+    * Write objects to a file, reading them natively and without creating any JS objects.
+    * In `"ndjson"` files each object is written as one line of JSON. `"csv"` files start with
+    * a header row, and write lists and nested objects as JSON. Dates are written as ISO 8601
+    * strings and `"data"` values as base64 strings, as read by {@link Realm.importJSON}.
+    *
+    * Linked objects are written as nested objects up to `linkDepth` levels deep. Deeper links
+    * are written as the primary key of the linked object, or `null` if it has none.
+    * @param {Realm~ObjectType|Realm.Results} source - The type of the objects to write, or
+    *   the results of a query of this Realm.
+    * @param {string} path - The path of the file to write. An existing file is replaced.
+    * @param {Object} [options]
+    * @param {string} [options.format="ndjson"] - `"ndjson"` or `"csv"`.
+    * @param {string[]} [options.projection] - The names of the properties to write, in the
+    *   order to write them. By default all properties are written.
+    * @param {number} [options.linkDepth=0] - The number of levels of linked objects to nest.
+    * @param {boolean} [options.background=false] - Write the file on a background thread.
+    *   The objects are read as of the time `exportTo()` was called. This can not be used
+    *   within a write transaction.
+    * @returns {Promise<Object>} A promise which is resolved with the number of `rows` written,
+    *   the `seconds` it took and the `rowsPerSecond` achieved.
+    * @since 1.3.0
+    */
+    exportTo(source, path, options) {}
+
+   /**
+    * Write a copy of the current version of this Realm to a new file. Only the objects are
+    * copied, so the copy is compacted and never contains the free space of this Realm's file.
+    * Writers are not blocked while the copy is written.
+    * @param {string} path - The path of the copy. A file must not exist at this path yet.
+    * @param {Object} [options]
+    * @param {ArrayBuffer|ArrayBufferView} [options.encryptionKey] - The 512-bit (64-byte)
+    *   key to encrypt the copy with. The copy is not encrypted by default.
+    * @param {boolean} [options.compact=true] - Copies are always compacted, so this can not
+    *   be `false`.
+    * @param {boolean} [options.background=false] - Write the copy on a background thread,
+    *   which copies the latest version of the Realm at the time it starts.
+    * @returns {Promise<Object>} A promise which is resolved with the size of the copy in
+    *   `bytes` and the `seconds` it took to write it.
+    * @throws {Error} If called within a write transaction.
+    * @since 1.3.0
+    */
+    writeCopyTo(path, options) {}
+
+   /**
+    * Rewrite the Realm file to contain only the data of its latest version, which releases
+    * the free space left behind by deleted objects and older versions.
+    * @returns {boolean} `true` if the Realm was compacted, or `false` if it is open in any
+    *   other `Realm` instance or process.
+    * @throws {Error} If called within a write transaction.
+    * @since 1.3.0
+    */
+    compact() {}
+
+   /**
+    * Get the size of the Realm file as `totalBytes`, split into the `usedBytes` taken by the
+    * latest version of the data and the `freeBytes` which can be reused or released by
+    * {@link Realm#compact compact()}.
+    * @returns {Object}
+    * @throws {Error} If the Realm was opened read-only from a file of an older file format.
+    * @since 1.3.0
+    */
+    getFileStats() {}
 }
 
 /**
@@ -170,6 +345,48 @@ class Realm {
  */
 Realm.schemaVersion = function(path, encryptionKey) {};
 
+/**
+ * Open a Realm without blocking the calling thread. Creating or upgrading the file, applying
+ * the schema and compacting the file (see `shouldCompactOnLaunch` of {@link Realm~Configuration})
+ * all happen on a background thread, after which the Realm is opened on the calling thread.
+ *
+ * A `migration` function has to run on the calling thread, so a Realm which needs one is
+ * migrated when it is finally opened.
+ * @param {Realm~Configuration|string} [config] - The configuration of the Realm, or its path.
+ * @returns {Promise<Realm>} - resolves with the opened Realm, or is rejected with the error
+ *   which opening it would have thrown.
+ * @since 1.3.0
+ */
+Realm.open = function(config) {};
+
+/**
+ * Create objects of the given `type` from JSON records, without loading all of them into
+ * memory at once. Files are read in chunks, while a buffer `source` is copied once before it
+ * is read. The records are parsed and written natively, and committed in write
+ * transactions of `batchSize` records. If a record can not be imported, the batch it belongs
+ * to is rolled back and an error naming the position of the record is thrown, while the
+ * batches committed before remain.
+ *
+ * Properties are read like the properties passed to {@link Realm#create create()}, where
+ * `"date"` values are given as milliseconds since the epoch, within the range of a `Date`,
+ * or as ISO 8601 strings, and `"data"` values as base64 strings.
+ * @param {Realm} realm - The Realm to import into. It must not be in a write transaction.
+ * @param {Realm~ObjectType} type - The type of the objects to create.
+ * @param {string|ArrayBuffer|ArrayBufferView} source - The path of a file, or the contents
+ *   of the JSON to import.
+ * @param {Object} [options]
+ * @param {string} [options.format="array"] - `"array"` if `source` contains an array of
+ *   records, or `"ndjson"` if it contains one record per line.
+ * @param {number} [options.batchSize=1000] - The number of records committed together.
+ * @param {boolean} [options.update=false] - Update existing objects with the same
+ *   primary key, as with `create()`.
+ * @param {function(number)} [options.progress] - Called with the number of imported records
+ *   after each batch has been committed.
+ * @returns {number} The number of imported records.
+ * @since 1.3.0
+ */
+Realm.importJSON = function(realm, type, source, options) {};
+
 /**
  * The default path where to create and access the Realm file.
  * @type {string}
@@ -182,17 +399,39 @@ Realm.defaultPath;
  * @type {Object}
  * @property {ArrayBuffer|ArrayBufferView} [encryptionKey] - The 512-bit (64-byte) encryption
  *   key used to encrypt and decrypt all data in the Realm.
- * @property {function(Realm, Realm)} [migration] - The function to run if a migration is needed.
+ * @property {string} [durability="full"] - `"full"` to store the Realm in its file, or
+ *   `"memory"`, which is the same as setting `inMemory`.
+ * @property {number} [groupCommitMs=0] - If greater than zero, blocks passed to
+ *   {@link Realm#queueWrite queueWrite()} within this many milliseconds of each other are
+ *   committed together in a single write transaction.
+ * @property {number} [groupCommitMax=0] - The largest number of blocks committed together when
+ *   `groupCommitMs` is set, or `0` for no limit.
+ * @property {function(Realm, Realm, Realm.Migration)} [migration] - The function to run if a migration is needed.
  *   This function should provide all the logic for converting data models from previous schemas
  *   to the new schema.
- *   This function takes two arguments:
+ *   This function takes three arguments:
  *   - `oldRealm` - The Realm before migration is performed.
  *   - `newRealm` - The Realm that uses the latest `schema`, which should be modified as necessary.
+ *   - `migration` - A {@link Realm.Migration} to rename, convert and fill whole properties natively.
+ * @property {boolean} [inMemory=false] - Keep the Realm in memory only. The data is discarded
+ *   when the last instance of the Realm at `path` is closed, and `path` only identifies the
+ *   Realm so other instances can share it.
  * @property {string} [path={@link Realm.defaultPath}] - The path to the file where the
  *   Realm database should be stored.
  * @property {boolean} [readOnly=false] - Specifies if this Realm should be opened as read-only.
+ * @property {function(number, number)} [upgradeProgress] - Called with the number of
+ *   converted rows and the total number of rows to convert while the dates of a Realm file
+ *   from file formats before version 5 are upgraded. The upgrade commits batches of rows, so
+ *   if it is interrupted it continues the next time the Realm is opened.
+ * @property {function(number, number)} [shouldCompactOnLaunch] - Called with the total size
+ *   of the file and the number of bytes used by data when an existing Realm file is opened,
+ *   before it is opened by this process. If it returns `true`, the file is compacted first.
+ *   It is not called for files which have to be upgraded from an older file format.
+ *   Can not be used with `readOnly`.
  * @property {Array<Realm~ObjectClass|Realm~ObjectSchema>} [schema] - Specifies all the
  *   object types in this Realm. **Required** when first creating a Realm at this `path`.
+ *   If the array, its object schemas and their `properties` and `indexes` are all frozen with
+ *   `Object.freeze()`, the array is parsed once and reused by every configuration given it.
  * @property {number} [schemaVersion] - **Required** (and must be incremented) after
  *   changing the `schema`.
  * @property {Object} [sync] - Sync configuration parameters with the following 
@@ -218,6 +457,11 @@ Realm.defaultPath;
  *   that must be unique across all objects of this type within the same Realm.
  * @property {Object<string, (Realm~PropertyType|Realm~ObjectSchemaProperty)>} properties -
  *   An object where the keys are property names and the values represent the property type.
+ * @property {Array<string[]>} [indexes] - Compound indexes, each given as an array of property
+ *   names (e.g. `[['chatId', 'ts']]`). Realm only has single-property indexes, so this only
+ *   indexes the first property of each entry, like `indexed: true` on that property would. The
+ *   other properties must exist and be indexable, but are not indexed. Only `"string"`, `"int"`,
+ *   `"bool"` and `"date"` properties may be listed.
  */
 
 /**
@@ -27,4 +27,35 @@
  * @memberof Realm
  */
 class Results extends Collection {
+    /**
+     * Evaluate the query of these results on a background thread instead of on the first
+     * access to `length` or an index.
+     * @returns {Promise<Realm.Results>} resolved with these results once the evaluated
+     *   query has been handed over to the calling thread.
+     * @since 1.3.0
+     */
+    evaluateAsync() {}
+
+    /**
+     * Create a Node.js readable stream over a snapshot of these results. Rows are materialized
+     * natively in batches and reading honors the stream's `highWaterMark`, so large results can
+     * be piped to a file or an HTTP response without blocking the event loop.
+     *
+     * Each row is a plain object. Linked objects and lists of them are given as the primary key
+     * of each linked object, or `null` for objects without a primary key, like in
+     * {@link Realm#exportTo exportTo()}.
+     * _Only available in Node.js._
+     * @param {Object} [options]
+     * @param {number} [options.batchSize=1000] - The number of objects materialized per chunk,
+     *   which must be a positive integer.
+     * @param {string[]} [options.projection] - The names of the properties to include in each row.
+     *   All properties are included if omitted.
+     * @param {string} [options.format="objects"] - Either `"objects"`, to stream arrays of plain
+     *   objects in object mode, or `"ndjson"`, to stream buffers of newline-delimited JSON.
+     * @param {number} [options.highWaterMark] - Passed on to the underlying `stream.Readable`.
+     * @throws {Error} If `batchSize` is not a positive integer or `format` is not supported.
+     * @returns {stream.Readable}
+     * @since 1.3.0
+     */
+    createReadStream(options) {}
 }
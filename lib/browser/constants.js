@@ -36,6 +36,7 @@ export const propTypes = {};
     'DICT',
     'FUNCTION',
     'LIST',
+    'MIGRATION',
     'OBJECT',
     'REALM',
     'RESULTS',
@@ -26,6 +26,7 @@ import Results, { createResults } from './results';
 import RealmObject, * as objects from './objects';
 import User, { createUser } from './user';
 import Session, { createSession } from './session';
+import Migration, { createMigration } from './migration';
 import * as rpc from './rpc';
 import * as util from './util';
 import { static as staticUserMethods } from '../user-methods';
@@ -38,6 +39,7 @@ rpc.registerTypeConverter(objectTypes.OBJECT, objects.createObject);
 rpc.registerTypeConverter(objectTypes.REALM, createRealm);
 rpc.registerTypeConverter(objectTypes.USER, createUser);
 rpc.registerTypeConverter(objectTypes.SESSION, createSession);
+rpc.registerTypeConverter(objectTypes.MIGRATION, createMigration);
 
 function createRealm(_, info) {
     let realm = Object.create(Realm.prototype);
@@ -52,6 +54,8 @@ function setupRealm(realm, realmId) {
     realm[keys.type] = objectTypes.REALM;
 
     [
+        'groupCommitMax',
+        'groupCommitMs',
         'path',
         'readOnly',
         'schema',
@@ -123,6 +127,11 @@ util.createMethods(Realm.prototype, objectTypes.REALM, [
     'addListener',
     'removeListener',
     'removeAllListeners',
+    'getNotificationStats',
+    '_exportTo',
+    '_writeCopyTo',
+    'compact',
+    'getFileStats',
     'close',
 ]);
 
@@ -130,7 +139,9 @@ util.createMethods(Realm.prototype, objectTypes.REALM, [
 util.createMethods(Realm.prototype, objectTypes.REALM, [
     'delete',
     'deleteAll',
+    'truncate',
     'write',
+    'savepoint',
 ], true);
 
 const Sync = {
@@ -148,6 +159,9 @@ Object.defineProperties(Realm, {
     Results: {
         value: Results,
     },
+    Migration: {
+        value: Migration,
+    },
     Object: {
         value: RealmObject,
     },
@@ -163,11 +177,23 @@ Object.defineProperties(Realm, {
             return rpc.callMethod(undefined, Realm[keys.id], 'schemaVersion', Array.from(arguments));
         }
     },
+    _prepareOpen: {
+        value: function(_config, _callback) {
+            return rpc.callMethod(undefined, Realm[keys.id], '_prepareOpen', Array.from(arguments));
+        }
+    },
     copyBundledRealmFiles: {
         value: function() {
             return rpc.callMethod(undefined, Realm[keys.id], 'copyBundledRealmFiles', []);
         }
     },
+    importJSON: {
+        value: function(realm, _type, _source, _options) {
+            let result = rpc.callMethod(undefined, Realm[keys.id], 'importJSON', Array.from(arguments));
+            collections.fireMutationListeners(realm[keys.realm]);
+            return result;
+        }
+    },
     clearTestState: {
         value: function() {
             collections.clearMutationListeners();
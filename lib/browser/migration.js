@@ -0,0 +1,43 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2016 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+'use strict';
+
+import { keys, objectTypes } from './constants';
+import { createMethods } from './util';
+
+export default class Migration { }
+
+createMethods(Migration.prototype, objectTypes.MIGRATION, [
+    'renameProperty',
+    'convertColumn',
+    'copyColumn',
+    'fillDefault',
+]);
+
+export function createMigration(realmId, info) {
+    let migrationProxy = Object.create(Migration.prototype);
+
+    // util/createMethod expects the realm id to be present on any object that is used over rpc.
+    migrationProxy[keys.realm] = "(Migration object)";
+
+    migrationProxy[keys.id] = info.id;
+    migrationProxy[keys.type] = objectTypes.MIGRATION;
+
+    return migrationProxy;
+}
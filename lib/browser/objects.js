@@ -30,6 +30,9 @@ export default class RealmObject {
 // Non-mutating methods:
 createMethods(RealmObject.prototype, objectTypes.OBJECT, [
     'isValid',
+    'addListener',
+    'removeListener',
+    'removeAllListeners',
 ]);
 
 export function clearRegisteredConstructors() {
@@ -30,6 +30,8 @@ createMethods(Results.prototype, objectTypes.RESULTS, [
     'sorted',
     'snapshot',
     'isValid',
+    '_evaluateAsync',
+    '_getBatch',
     'addListener',
     'removeListener',
     'removeAllListeners',
@@ -40,6 +40,12 @@ module.exports = function(realmConstructor) {
     setConstructorOnPrototype(realmConstructor.Results);
     setConstructorOnPrototype(realmConstructor.Object);
 
+    // Add Realm and Results methods implemented on top of the native ones
+    let realmMethods = require('./realm-methods');
+    Object.defineProperties(realmConstructor, getOwnPropertyDescriptors(realmMethods.static));
+    Object.defineProperties(realmConstructor.prototype, getOwnPropertyDescriptors(realmMethods.instance));
+    Object.defineProperties(realmConstructor.Results.prototype, getOwnPropertyDescriptors(require('./results-methods')));
+
     // Add sync methods
     if (realmConstructor.Sync) {
         let userMethods = require('./user-methods');
@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2016 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+'use strict';
+
+// Write blocks waiting for the group commit of their Realm.
+const writeGroups = new WeakMap();
+
+// Runs all blocks of the group in a single write transaction. A block which throws is rejected
+// and the transaction is rolled back, then the remaining blocks are run again without it.
+function commitWriteGroup(realm, group) {
+    clearTimeout(group.timer);
+    if (writeGroups.get(realm) === group) {
+        writeGroups.delete(realm);
+    }
+
+    let blocks = group.blocks;
+    while (blocks.length) {
+        let results = [];
+        let failed = -1;
+        let failure;
+
+        try {
+            realm.write(() => {
+                for (let i = 0; i < blocks.length; i++) {
+                    try {
+                        results.push(blocks[i].callback());
+                    }
+                    catch (e) {
+                        failed = i;
+                        failure = e;
+                        throw e;
+                    }
+                }
+            });
+        }
+        catch (e) {
+            if (failed < 0) {
+                // The commit itself failed, which affects every block.
+                blocks.forEach((block) => block.reject(e));
+                return;
+            }
+
+            blocks[failed].reject(failure);
+            blocks = blocks.filter((block, index) => index != failed);
+            continue;
+        }
+
+        blocks.forEach((block, index) => block.resolve(results[index]));
+        return;
+    }
+}
+
+// Calls a native method which reports its result to an (error, result) callback passed as its
+// last argument, and returns a promise for that result.
+function callWithCallback(realm, method, args) {
+    return new Promise((resolve, reject) => {
+        realm[method].apply(realm, args.concat((error, result) => {
+            if (error) {
+                reject(new Error(error));
+            } else {
+                resolve(result);
+            }
+        }));
+    });
+}
+
+module.exports = {
+    static: {
+        open(config) {
+            if (typeof config == 'string') {
+                config = { path: config };
+            }
+            config = Object.assign({}, config);
+
+            // The file is prepared on a background thread, after which opening it here is fast.
+            return callWithCallback(this, '_prepareOpen', [config]).then(() => {
+                delete config.shouldCompactOnLaunch;
+                delete config.upgradeProgress;
+                return new this(config);
+            });
+        },
+    },
+
+    instance: {
+        objectsAsync(type) {
+            return this.objects(type).evaluateAsync();
+        },
+
+        queueWrite(callback) {
+            // Without a group commit window, this would be nothing but write() returning a promise.
+            if (!(this.groupCommitMs > 0)) {
+                throw new Error('queueWrite() can only be used with Realms opened with groupCommitMs.');
+            }
+
+            return new Promise((resolve, reject) => {
+                let group = writeGroups.get(this);
+                if (!group) {
+                    group = { blocks: [], timer: setTimeout(() => commitWriteGroup(this, group), this.groupCommitMs) };
+                    writeGroups.set(this, group);
+                }
+
+                group.blocks.push({ callback, resolve, reject });
+                if (this.groupCommitMax > 0 && group.blocks.length >= this.groupCommitMax) {
+                    commitWriteGroup(this, group);
+                }
+            });
+        },
+
+        exportTo(source, path, options) {
+            return callWithCallback(this, '_exportTo', [source, path, options]);
+        },
+
+        writeCopyTo(path, options) {
+            return callWithCallback(this, '_writeCopyTo', [path, options]);
+        },
+    },
+};
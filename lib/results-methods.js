@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2016 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+'use strict';
+
+function node_require(module) {
+    return require(module);
+}
+
+module.exports = {
+    evaluateAsync() {
+        return new Promise((resolve, reject) => {
+            this._evaluateAsync((error, results) => {
+                if (error) {
+                    reject(new Error(error));
+                } else {
+                    resolve(results);
+                }
+            });
+        });
+    },
+
+    createReadStream(options) {
+        options = options || {};
+
+        const Readable = node_require('stream').Readable;
+        const batchSize = options.batchSize === undefined ? 1000 : options.batchSize;
+        const format = options.format || 'objects';
+        const projection = options.projection;
+
+        if (typeof batchSize != 'number' || batchSize < 1 || Math.floor(batchSize) !== batchSize) {
+            throw new Error(`batchSize must be a positive integer, got '${batchSize}'`);
+        }
+        if (format !== 'objects' && format !== 'ndjson') {
+            throw new Error(`Unsupported stream format '${format}'`);
+        }
+
+        // The snapshot keeps the streamed rows stable for as long as the stream is being read.
+        let snapshot = this.snapshot();
+        let position = 0;
+
+        return new Readable({
+            objectMode: format === 'objects',
+            highWaterMark: options.highWaterMark,
+            read() {
+                while (snapshot) {
+                    if (position >= snapshot.length) {
+                        snapshot = null;
+                        this.push(null);
+                        return;
+                    }
+
+                    const rows = snapshot._getBatch(position, batchSize, projection);
+                    position += batchSize;
+                    if (rows.length === 0) {
+                        continue;
+                    }
+
+                    const chunk = format === 'ndjson'
+                        ? Buffer.from(rows.map((row) => JSON.stringify(row)).join('\n') + '\n')
+                        : rows;
+                    if (!this.push(chunk)) {
+                        return;
+                    }
+                }
+            },
+        });
+    },
+};
@@ -0,0 +1,283 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2016 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include <realm/mixed.hpp>
+#include <realm/table.hpp>
+
+#include "timestamp_format.hpp"
+
+namespace realm {
+
+// Copies, converts and fills whole columns during a migration, reading and writing the values
+// directly instead of going through objects.
+class ColumnMigrator {
+  public:
+    // Copies the values of a column of the table in the Realm before the migration into a
+    // column of the migrated table, converting them to the type of that column. Rows are
+    // matched by index, so both tables must still have the same rows.
+    static void copy(const Table &from_table, size_t from_column, Table &to_table, size_t to_column) {
+        validate_column(from_table, from_column);
+        validate_column(to_table, to_column);
+        if (from_table.size() != to_table.size()) {
+            throw std::runtime_error("Objects of '" + std::string(to_table.get_name()) + "' were added or deleted before the column was copied.");
+        }
+
+        bool from_nullable = from_table.is_nullable(from_column);
+        for (size_t row = 0, size = from_table.size(); row < size; ++row) {
+            if (from_nullable && from_table.is_null(from_column, row)) {
+                set_null(to_table, to_column, row);
+            }
+            else {
+                set(to_table, to_column, row, get(from_table, from_column, row));
+            }
+        }
+    }
+
+    static void fill(Table &table, size_t column, Mixed value) {
+        validate_column(table, column);
+        for (size_t row = 0, size = table.size(); row < size; ++row) {
+            set(table, column, row, value);
+        }
+    }
+
+    static void fill_null(Table &table, size_t column) {
+        validate_column(table, column);
+        for (size_t row = 0, size = table.size(); row < size; ++row) {
+            set_null(table, column, row);
+        }
+    }
+
+  private:
+    static void validate_column(const Table &table, size_t column) {
+        switch (table.get_column_type(column)) {
+            case type_Int:
+            case type_Bool:
+            case type_Float:
+            case type_Double:
+            case type_String:
+            case type_Binary:
+            case type_Timestamp:
+                return;
+            default:
+                throw std::invalid_argument("Column '" + std::string(table.get_column_name(column)) + "' of '" +
+                                            std::string(table.get_name()) + "' can not be migrated natively.");
+        }
+    }
+
+    static Mixed get(const Table &table, size_t column, size_t row) {
+        switch (table.get_column_type(column)) {
+            case type_Int:
+                return Mixed(table.get_int(column, row));
+            case type_Bool:
+                return Mixed(table.get_bool(column, row));
+            case type_Float:
+                return Mixed(table.get_float(column, row));
+            case type_Double:
+                return Mixed(table.get_double(column, row));
+            case type_String:
+                return Mixed(table.get_string(column, row));
+            case type_Binary:
+                return Mixed(table.get_binary(column, row));
+            case type_Timestamp:
+                return Mixed(table.get_timestamp(column, row));
+            default:
+                REALM_UNREACHABLE();
+        }
+    }
+
+    static void set_null(Table &table, size_t column, size_t row) {
+        if (!table.is_nullable(column)) {
+            throw std::invalid_argument("Column '" + std::string(table.get_column_name(column)) + "' of '" +
+                                        std::string(table.get_name()) + "' can not be set to null.");
+        }
+        table.set_null(column, row);
+    }
+
+    static void set(Table &table, size_t column, size_t row, const Mixed &value) {
+        switch (table.get_column_type(column)) {
+            case type_Int:
+                table.set_int(column, row, to_int(value));
+                break;
+            case type_Bool:
+                table.set_bool(column, row, to_bool(value));
+                break;
+            case type_Float:
+                table.set_float(column, row, (float)to_double(value));
+                break;
+            case type_Double:
+                table.set_double(column, row, to_double(value));
+                break;
+            case type_String: {
+                std::string string = to_string(value);
+                table.set_string(column, row, string);
+                break;
+            }
+            case type_Binary:
+                table.set_binary(column, row, to_binary(value));
+                break;
+            case type_Timestamp:
+                table.set_timestamp(column, row, to_timestamp(value));
+                break;
+            default:
+                REALM_UNREACHABLE();
+        }
+    }
+
+    static int64_t to_int(const Mixed &value) {
+        switch (value.get_type()) {
+            case type_Int:
+                return value.get_int();
+            case type_Bool:
+                return value.get_bool() ? 1 : 0;
+            case type_Float:
+            case type_Double: {
+                // Casting a double outside the range of int64_t is undefined, as is NaN.
+                double number = to_double(value);
+                double min = (double)std::numeric_limits<int64_t>::min();
+                if (!(number >= min && number < -min)) {
+                    throw std::invalid_argument("Can not convert " + to_string(value) + " to an int.");
+                }
+                return (int64_t)number;
+            }
+            case type_String: {
+                std::string string = value.get_string();
+                char *end;
+                errno = 0;
+                long long number = strtoll(string.c_str(), &end, 10);
+                if (string.empty() || *end || errno == ERANGE) {
+                    throw std::invalid_argument("Can not convert '" + string + "' to an int.");
+                }
+                return number;
+            }
+            case type_Timestamp:
+                return to_milliseconds(value.get_timestamp());
+            default:
+                throw unsupported(value, "int");
+        }
+    }
+
+    static double to_double(const Mixed &value) {
+        switch (value.get_type()) {
+            case type_Int:
+                return (double)value.get_int();
+            case type_Bool:
+                return value.get_bool() ? 1 : 0;
+            case type_Float:
+                return value.get_float();
+            case type_Double:
+                return value.get_double();
+            case type_String: {
+                std::string string = value.get_string();
+                char *end;
+                double number = strtod(string.c_str(), &end);
+                if (string.empty() || *end) {
+                    throw std::invalid_argument("Can not convert '" + string + "' to a number.");
+                }
+                return number;
+            }
+            case type_Timestamp:
+                return (double)to_milliseconds(value.get_timestamp());
+            default:
+                throw unsupported(value, "number");
+        }
+    }
+
+    static bool to_bool(const Mixed &value) {
+        switch (value.get_type()) {
+            case type_Int:
+                return value.get_int() != 0;
+            case type_Bool:
+                return value.get_bool();
+            case type_String: {
+                std::string string = value.get_string();
+                if (string != "true" && string != "false") {
+                    throw std::invalid_argument("Can not convert '" + string + "' to a bool.");
+                }
+                return string == "true";
+            }
+            default:
+                throw unsupported(value, "bool");
+        }
+    }
+
+    static std::string to_string(const Mixed &value) {
+        char string[32];
+        switch (value.get_type()) {
+            case type_Int:
+                return std::to_string(value.get_int());
+            case type_Bool:
+                return value.get_bool() ? "true" : "false";
+            case type_Float:
+                snprintf(string, sizeof(string), "%.9g", value.get_float());
+                return string;
+            case type_Double:
+                snprintf(string, sizeof(string), "%.17g", value.get_double());
+                return string;
+            case type_String:
+                return value.get_string();
+            case type_Timestamp:
+                return format_timestamp(value.get_timestamp());
+            default:
+                throw unsupported(value, "string");
+        }
+    }
+
+    static BinaryData to_binary(const Mixed &value) {
+        if (value.get_type() != type_Binary) {
+            throw unsupported(value, "data");
+        }
+        return value.get_binary();
+    }
+
+    static Timestamp to_timestamp(const Mixed &value) {
+        switch (value.get_type()) {
+            case type_Timestamp:
+                return value.get_timestamp();
+            case type_Int:
+            case type_Float:
+            case type_Double: {
+                // Numbers are milliseconds since the epoch, like the time value of a JS Date.
+                return timestamp_from_milliseconds(to_double(value));
+            }
+            default:
+                throw unsupported(value, "date");
+        }
+    }
+
+    static int64_t to_milliseconds(Timestamp timestamp) {
+        return timestamp.get_seconds() * 1000 + timestamp.get_nanoseconds() / 1000000;
+    }
+
+    static std::invalid_argument unsupported(const Mixed &value, const char *type) {
+        // Indexed by DataType, for the types allowed by validate_column().
+        static const char *type_names[] = {"int", "bool", "string", "", "data", "", "", "", "date", "float", "double"};
+        return std::invalid_argument(std::string("Can not convert '") + type_names[value.get_type()] + "' values to '" + type + "'.");
+    }
+};
+
+} // realm
@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2016 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+
+#include "object_schema.hpp"
+#include "object_store.hpp"
+#include "property.hpp"
+#include "shared_realm.hpp"
+
+namespace realm {
+
+// Files upgraded from file formats before 5 store dates as milliseconds, which have to be
+// converted to seconds and nanoseconds. The conversion commits batches of rows and records the
+// next row of each column to convert in a table of its own, so an interrupted conversion is
+// resumed the next time the file is opened.
+//
+// Only the rows which existed when the conversion started are converted, since rows added
+// later already store seconds. Every Realm opened by this binding finishes the conversion
+// before it can be written to, so rows are not removed while it is in progress.
+class DatetimeUpgrade {
+  public:
+    using ProgressHandler = std::function<void(size_t converted, size_t total)>;
+
+    static constexpr const char *progress_table_name = "realmjs_datetime_upgrade";
+    static const size_t default_batch_size = 10000;
+
+    explicit DatetimeUpgrade(SharedRealm realm) : m_realm(std::move(realm)) {}
+
+    bool is_needed() const {
+        // Read-only Realms neither upgrade the file nor can they finish a conversion.
+        if (m_realm->config().read_only()) {
+            return false;
+        }
+        auto old_file_format_version = m_realm->file_format_upgraded_from_version();
+        return (old_file_format_version && *old_file_format_version < 5) || m_realm->read_group().has_table(progress_table_name);
+    }
+
+    void run(const ProgressHandler &progress = nullptr, size_t batch_size = default_batch_size) {
+        if (!is_needed()) {
+            return;
+        }
+
+        m_realm->begin_transaction();
+        size_t total = prepare();
+        m_realm->commit_transaction();
+
+        size_t converted = 0;
+        while (true) {
+            m_realm->begin_transaction();
+            Group &group = m_realm->read_group();
+            TableRef progress_table = group.get_table(progress_table_name);
+            if (progress_table->is_empty()) {
+                group.remove_table(progress_table_name);
+                m_realm->commit_transaction();
+                return;
+            }
+
+            TableRef table = group.get_table(progress_table->get_string(table_column, 0));
+            size_t column = table->get_column_index(progress_table->get_string(column_column, 0));
+            size_t begin = progress_table->get_int(next_row_column, 0);
+            size_t end_row = std::min<size_t>(progress_table->get_int(end_row_column, 0), table->size());
+            size_t end = std::min(begin + batch_size, end_row);
+
+            for (size_t row = begin; row < end; ++row) {
+                if (table->is_null(column, row)) {
+                    continue;
+                }
+                auto milliseconds = table->get_timestamp(column, row).get_seconds();
+                table->set_timestamp(column, row, Timestamp(milliseconds / 1000, (milliseconds % 1000) * 1000000));
+            }
+
+            if (end >= end_row) {
+                progress_table->remove(0);
+            }
+            else {
+                progress_table->set_int(next_row_column, 0, end);
+            }
+            m_realm->commit_transaction();
+
+            if (end <= begin) {
+                continue;
+            }
+            converted += end - begin;
+            if (progress) {
+                progress(converted, total);
+            }
+        }
+    }
+
+  private:
+    static const size_t table_column = 0;
+    static const size_t column_column = 1;
+    static const size_t next_row_column = 2;
+    static const size_t end_row_column = 3;
+
+    SharedRealm m_realm;
+
+    // Lists the date columns to convert if the conversion has not been started yet, and returns
+    // the number of rows left to convert.
+    size_t prepare() {
+        Group &group = m_realm->read_group();
+        TableRef progress_table = group.get_table(progress_table_name);
+        if (!progress_table) {
+            progress_table = group.add_table(progress_table_name);
+            progress_table->add_column(type_String, "table");
+            progress_table->add_column(type_String, "column");
+            progress_table->add_column(type_Int, "next_row");
+            progress_table->add_column(type_Int, "end_row");
+
+            for (auto &object_schema : m_realm->schema()) {
+                TableRef table = ObjectStore::table_for_object_type(group, object_schema.name);
+                for (auto &property : object_schema.persisted_properties) {
+                    if (property.type == PropertyType::Date) {
+                        size_t row = progress_table->add_empty_row();
+                        progress_table->set_string(table_column, row, table->get_name());
+                        progress_table->set_string(column_column, row, property.name);
+                        progress_table->set_int(end_row_column, row, table->size());
+                    }
+                }
+            }
+        }
+
+        size_t total = 0;
+        for (size_t row = 0; row < progress_table->size(); ++row) {
+            size_t next_row = progress_table->get_int(next_row_column, row);
+            size_t end_row = progress_table->get_int(end_row_column, row);
+            total += end_row > next_row ? end_row - next_row : 0;
+        }
+        return total;
+    }
+};
+
+} // realm
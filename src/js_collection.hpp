@@ -18,11 +18,20 @@
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+
+#include "event_loop_dispatcher.hpp"
 #include "js_class.hpp"
 #include "js_types.hpp"
 #include "js_observable.hpp"
+#include "notification_stats.hpp"
+#include "timer_queue.hpp"
 
 #include "collection_notifications.hpp"
+#include "collection_change_builder.hpp"
 
 namespace realm {
 namespace js {
@@ -30,38 +39,227 @@ namespace js {
 // Empty class that merely serves as useful type for now.
 class Collection {};
 
+// Options that may be passed as the second argument to a collection's addListener().
+struct CollectionListenerOptions {
+    // Report changed indexes as [start, end) pairs instead of one number per index.
+    bool ranges = false;
+
+    // Minimum time between two calls to the listener, from 'throttleMs' or 'maxPerSecond'.
+    std::chrono::milliseconds throttle{0};
+
+    // Time without further changes to wait for before calling the listener, from 'debounceMs'.
+    std::chrono::milliseconds debounce{0};
+
+    bool coalesces() const {
+        return throttle.count() || debounce.count();
+    }
+};
+
+// Merges the change sets delivered to a throttled or debounced listener and passes the merged
+// change set on once the listener's policy allows it. Lives on, and is only called from, the JS thread.
+class CoalescingDelivery : public std::enable_shared_from_this<CoalescingDelivery> {
+  public:
+    using Deliver = std::function<void(CollectionChangeSet)>;
+
+    static std::shared_ptr<CoalescingDelivery> create(const CollectionListenerOptions &options, Deliver deliver) {
+        auto delivery = std::shared_ptr<CoalescingDelivery>(new CoalescingDelivery(options, std::move(deliver)));
+        std::weak_ptr<CoalescingDelivery> weak_delivery = delivery;
+        delivery->m_flush = std::make_shared<EventLoopDispatcher<void(uint64_t)>>([weak_delivery](uint64_t generation) {
+            if (auto delivery = weak_delivery.lock()) {
+                delivery->flush(generation);
+            }
+        });
+        return delivery;
+    }
+
+    void operator()(CollectionChangeSet change_set) {
+        // The initial notification is passed on as is.
+        if (change_set.empty() && !m_has_pending) {
+            m_deliver(std::move(change_set));
+            return;
+        }
+
+        _impl::CollectionChangeBuilder changes(std::move(change_set.deletions), std::move(change_set.insertions),
+                                               std::move(change_set.modifications), std::move(change_set.moves));
+        // Keep the modified columns so that the merged change set still says which properties changed.
+        changes.columns = std::move(change_set.columns);
+        m_pending.merge(std::move(changes));
+        m_has_pending = true;
+
+        auto now = TimerQueue::Clock::now();
+        if (m_debounce.count()) {
+            // Rescheduling invalidates the flush scheduled for the previous change.
+            schedule(now + m_debounce);
+        }
+        else if (!m_flush_scheduled) {
+            auto next_delivery = m_last_delivery + m_throttle;
+            if (next_delivery <= now) {
+                flush(m_generation);
+            }
+            else {
+                schedule(next_delivery);
+            }
+        }
+    }
+
+  private:
+    CoalescingDelivery(const CollectionListenerOptions &options, Deliver deliver)
+        : m_deliver(std::move(deliver)), m_throttle(options.throttle), m_debounce(options.debounce) {}
+
+    void schedule(TimerQueue::Clock::time_point deadline) {
+        uint64_t generation = ++m_generation;
+        auto flush = m_flush;
+        m_flush_scheduled = true;
+        TimerQueue::shared().schedule(deadline, [flush, generation] {
+            (*flush)(generation);
+        });
+    }
+
+    void flush(uint64_t generation) {
+        if (generation != m_generation || !m_has_pending) {
+            return;
+        }
+
+        CollectionChangeSet change_set = std::move(m_pending).finalize();
+        m_pending = _impl::CollectionChangeBuilder();
+        m_has_pending = false;
+        m_flush_scheduled = false;
+        m_last_delivery = TimerQueue::Clock::now();
+
+        m_deliver(std::move(change_set));
+    }
+
+    const Deliver m_deliver;
+    const std::chrono::milliseconds m_throttle;
+    const std::chrono::milliseconds m_debounce;
+
+    std::shared_ptr<EventLoopDispatcher<void(uint64_t)>> m_flush;
+    _impl::CollectionChangeBuilder m_pending;
+    bool m_has_pending = false;
+    bool m_flush_scheduled = false;
+    uint64_t m_generation = 0;
+    TimerQueue::Clock::time_point m_last_delivery;
+};
+
+// Creates the callback registered with the object store for a collection listener, applying the
+// delivery policy from the listener's options before the listener is called.
+static inline std::function<void(CollectionChangeSet, std::exception_ptr)> make_listener_callback(const CollectionListenerOptions &options, CoalescingDelivery::Deliver deliver) {
+    if (!options.coalesces()) {
+        return [=](CollectionChangeSet change_set, std::exception_ptr) {
+            deliver(std::move(change_set));
+        };
+    }
+
+    auto delivery = CoalescingDelivery::create(options, std::move(deliver));
+    return [=](CollectionChangeSet change_set, std::exception_ptr) {
+        (*delivery)(std::move(change_set));
+    };
+}
+
 template<typename T>
 struct CollectionClass : ClassDefinition<T, Collection, ObservableClass<T>> {
     using ContextType = typename T::Context;
     using ValueType = typename T::Value;
     using ObjectType = typename T::Object;
+    using String = js::String<T>;
     using Object = js::Object<T>;
     using Value = js::Value<T>;
 
     std::string const name = "Collection";
     
-    static inline ValueType create_collection_change_set(ContextType ctx, const CollectionChangeSet &change_set);
+    static inline CollectionListenerOptions parse_listener_options(ContextType ctx, const ValueType &value);
+    static inline ValueType create_collection_change_set(ContextType ctx, const CollectionChangeSet &change_set, const CollectionListenerOptions &options = {});
+
+  private:
+    static inline ValueType create_index_array(ContextType ctx, const IndexSet &index_set, bool ranges);
 };
 
 template<typename T>
-typename T::Value CollectionClass<T>::create_collection_change_set(ContextType ctx, const CollectionChangeSet &change_set)
+CollectionListenerOptions CollectionClass<T>::parse_listener_options(ContextType ctx, const ValueType &value)
 {
-    ObjectType object = Object::create_empty(ctx);
-    std::vector<ValueType> deletions, insertions, modifications;
-    for (auto index : change_set.deletions.as_indexes()) {
-        deletions.push_back(Value::from_number(ctx, index));
+    static const String ranges_string = "ranges";
+    static const String throttle_ms_string = "throttleMs";
+    static const String debounce_ms_string = "debounceMs";
+    static const String max_per_second_string = "maxPerSecond";
+
+    CollectionListenerOptions options;
+    ObjectType object = Value::validated_to_object(ctx, value, "options");
+
+    ValueType ranges_value = Object::get_property(ctx, object, ranges_string);
+    if (!Value::is_undefined(ctx, ranges_value)) {
+        options.ranges = Value::validated_to_boolean(ctx, ranges_value, "ranges");
     }
-    Object::set_property(ctx, object, "deletions", Object::create_array(ctx, deletions));
-    
-    for (auto index : change_set.insertions.as_indexes()) {
-        insertions.push_back(Value::from_number(ctx, index));
+
+    ValueType throttle_value = Object::get_property(ctx, object, throttle_ms_string);
+    if (!Value::is_undefined(ctx, throttle_value)) {
+        double throttle_ms = Value::validated_to_number(ctx, throttle_value, "throttleMs");
+        if (throttle_ms < 0) {
+            throw std::invalid_argument("'throttleMs' must not be negative");
+        }
+        options.throttle = std::chrono::milliseconds((int64_t)throttle_ms);
     }
-    Object::set_property(ctx, object, "insertions", Object::create_array(ctx, insertions));
-    
-    for (auto index : change_set.modifications.as_indexes()) {
-        modifications.push_back(Value::from_number(ctx, index));
+
+    ValueType max_per_second_value = Object::get_property(ctx, object, max_per_second_string);
+    if (!Value::is_undefined(ctx, max_per_second_value)) {
+        double max_per_second = Value::validated_to_number(ctx, max_per_second_value, "maxPerSecond");
+        if (max_per_second <= 0) {
+            throw std::invalid_argument("'maxPerSecond' must be greater than zero");
+        }
+        options.throttle = std::max(options.throttle, std::chrono::milliseconds((int64_t)(1000 / max_per_second)));
+    }
+
+    ValueType debounce_value = Object::get_property(ctx, object, debounce_ms_string);
+    if (!Value::is_undefined(ctx, debounce_value)) {
+        double debounce_ms = Value::validated_to_number(ctx, debounce_value, "debounceMs");
+        if (debounce_ms < 0) {
+            throw std::invalid_argument("'debounceMs' must not be negative");
+        }
+        options.debounce = std::chrono::milliseconds((int64_t)debounce_ms);
+    }
+
+    if (options.throttle.count() && options.debounce.count()) {
+        throw std::invalid_argument("A listener cannot be both throttled and debounced");
+    }
+
+    return options;
+}
+
+template<typename T>
+typename T::Value CollectionClass<T>::create_index_array(ContextType ctx, const IndexSet &index_set, bool ranges)
+{
+    std::vector<ValueType> values;
+    if (ranges) {
+        // IndexSet already stores its indexes as ranges, so this is proportional to the number of ranges.
+        for (auto range : index_set) {
+            ValueType pair[2] = {Value::from_number(ctx, range.first), Value::from_number(ctx, range.second)};
+            values.push_back(Object::create_array(ctx, 2, pair));
+        }
+    }
+    else {
+        for (auto index : index_set.as_indexes()) {
+            values.push_back(Value::from_number(ctx, index));
+        }
+    }
+    return Object::create_array(ctx, values);
+}
+
+template<typename T>
+typename T::Value CollectionClass<T>::create_collection_change_set(ContextType ctx, const CollectionChangeSet &change_set, const CollectionListenerOptions &options)
+{
+    ObjectType object = Object::create_empty(ctx);
+    Object::set_property(ctx, object, "deletions", create_index_array(ctx, change_set.deletions, options.ranges));
+    Object::set_property(ctx, object, "insertions", create_index_array(ctx, change_set.insertions, options.ranges));
+    Object::set_property(ctx, object, "modifications", create_index_array(ctx, change_set.modifications, options.ranges));
+
+    std::vector<ValueType> moves;
+    moves.reserve(change_set.moves.size());
+    for (auto &move : change_set.moves) {
+        ObjectType move_object = Object::create_empty(ctx);
+        Object::set_property(ctx, move_object, "from", Value::from_number(ctx, move.from));
+        Object::set_property(ctx, move_object, "to", Value::from_number(ctx, move.to));
+        moves.push_back(move_object);
     }
-    Object::set_property(ctx, object, "modifications", Object::create_array(ctx, modifications));
+    Object::set_property(ctx, object, "moves", Object::create_array(ctx, moves));
 
     return object;
 }
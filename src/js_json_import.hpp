@@ -0,0 +1,444 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2016 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <istream>
+#include <map>
+#include <vector>
+
+#include "js_types.hpp"
+#include "js_util.hpp"
+#include "notification_stats.hpp"
+
+#include "base64.hpp"
+#include "json.hpp"
+
+#include "object_accessor.hpp"
+#include "shared_realm.hpp"
+#include "timestamp_format.hpp"
+
+namespace realm {
+namespace js {
+
+// Splits a JSON array into the text of its elements as the document is fed to it in chunks,
+// so that each element can be parsed on its own. Only the element being read is buffered.
+class JSONArraySplitter {
+  public:
+    template<typename Callback>
+    void feed(const char *data, size_t size, Callback &&element) {
+        for (const char *end = data + size; data != end; ++data) {
+            char c = *data;
+            if (m_state == State::InElement) {
+                m_element += c;
+                if (m_in_string) {
+                    if (m_escaped) {
+                        m_escaped = false;
+                    }
+                    else if (c == '\\') {
+                        m_escaped = true;
+                    }
+                    else if (c == '"') {
+                        m_in_string = false;
+                    }
+                }
+                else if (c == '"') {
+                    m_in_string = true;
+                }
+                else if (c == '{' || c == '[') {
+                    ++m_depth;
+                }
+                else if ((c == '}' || c == ']') && --m_depth == 0) {
+                    element(m_element);
+                    m_element.clear();
+                    m_state = State::AfterElement;
+                }
+                continue;
+            }
+
+            if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+                continue;
+            }
+            switch (m_state) {
+                case State::BeforeArray:
+                    if (c != '[') {
+                        throw std::invalid_argument("The JSON to import must contain an array of objects.");
+                    }
+                    m_state = State::FirstElement;
+                    break;
+                case State::FirstElement:
+                case State::NextElement:
+                    if (c == ']' && m_state == State::FirstElement) {
+                        m_state = State::AfterArray;
+                    }
+                    else if (c == '{') {
+                        m_element = c;
+                        m_depth = 1;
+                        m_state = State::InElement;
+                    }
+                    else {
+                        throw std::invalid_argument("The JSON to import must contain an array of objects.");
+                    }
+                    break;
+                case State::AfterElement:
+                    if (c == ',') {
+                        m_state = State::NextElement;
+                    }
+                    else if (c == ']') {
+                        m_state = State::AfterArray;
+                    }
+                    else {
+                        throw std::invalid_argument(std::string("Unexpected '") + c + "' in the JSON to import.");
+                    }
+                    break;
+                default:
+                    throw std::invalid_argument(std::string("Unexpected '") + c + "' after the JSON array to import.");
+            }
+        }
+    }
+
+    // Throws if the array has not been closed.
+    void finish() const {
+        if (m_state != State::AfterArray) {
+            throw std::invalid_argument("Unexpected end of the JSON to import.");
+        }
+    }
+
+  private:
+    enum class State { BeforeArray, FirstElement, NextElement, InElement, AfterElement, AfterArray };
+
+    State m_state = State::BeforeArray;
+    std::string m_element;
+    size_t m_depth = 0;
+    bool m_in_string = false;
+    bool m_escaped = false;
+};
+
+// Creates objects of one type from a stream of JSON records, committing them in batches. The
+// records are parsed one at a time and written through a NativeAccessor for JSON values, so
+// only the record being imported has to be held in memory besides the input.
+template<typename T>
+class JSONImporter {
+    using ContextType = typename T::Context;
+    using FunctionType = typename T::Function;
+    using ObjectType = typename T::Object;
+    using ValueType = typename T::Value;
+    using Object = js::Object<T>;
+    using Value = js::Value<T>;
+    using json = nlohmann::json;
+
+  public:
+    struct Options {
+        bool ndjson = false;
+        size_t batch_size = 1000;
+        bool update = false;
+        util::Optional<FunctionType> progress;
+    };
+
+    JSONImporter(ContextType ctx, SharedRealm realm, const ObjectSchema &object_schema, Options options)
+        : m_ctx(ctx), m_realm(realm), m_object_schema(object_schema), m_options(options) {}
+
+    // Returns the number of imported records. If an error occurs, the batch being imported is
+    // rolled back, while the batches committed before remain.
+    size_t import(std::istream &stream) {
+        return run([&] {
+            if (m_options.ndjson) {
+                std::string line;
+                while (std::getline(stream, line)) {
+                    import_line(line);
+                }
+                return;
+            }
+
+            JSONArraySplitter splitter;
+            std::vector<char> chunk(chunk_size);
+            while (stream.read(chunk.data(), chunk.size()) || stream.gcount()) {
+                splitter.feed(chunk.data(), (size_t)stream.gcount(), [this](const std::string &element) {
+                    import_record(json::parse(element));
+                });
+            }
+            splitter.finish();
+        });
+    }
+
+    // Imports the records of a document which is already in memory, without copying it.
+    size_t import(const char *data, size_t size) {
+        return run([&] {
+            if (m_options.ndjson) {
+                const char *end = data + size;
+                while (data != end) {
+                    const char *line_end = std::find(data, end, '\n');
+                    import_line(std::string(data, line_end));
+                    data = line_end == end ? end : line_end + 1;
+                }
+                return;
+            }
+
+            JSONArraySplitter splitter;
+            splitter.feed(data, size, [this](const std::string &element) {
+                import_record(json::parse(element));
+            });
+            splitter.finish();
+        });
+    }
+
+    bool has_default_value(const ObjectSchema &object_schema, const std::string &prop_name) {
+        auto &defaults = get_delegate<T>(m_realm.get())->m_defaults[object_schema.name];
+        return defaults.count(prop_name) != 0;
+    }
+
+    // Default values are given as JS values, so they are converted through JSON.stringify().
+    const json *default_value(const ObjectSchema &object_schema, const std::string &prop_name) {
+        auto key = std::make_pair(object_schema.name, prop_name);
+        auto cached = m_defaults.find(key);
+        if (cached != m_defaults.end()) {
+            return &cached->second;
+        }
+
+        auto &defaults = get_delegate<T>(m_realm.get())->m_defaults[object_schema.name];
+        ValueType value = defaults.at(prop_name);
+
+        // Binary values are imported from base64 strings.
+        if (object_schema.property_for_name(prop_name)->type == PropertyType::Data) {
+            std::string data = realm::NativeAccessor<ValueType, ContextType>::to_binary(m_ctx, value);
+            return &m_defaults.emplace(key, json(base64_encode((const unsigned char *)data.data(), data.size()))).first->second;
+        }
+
+        ObjectType json_object = Value::validated_to_object(m_ctx, Object::get_global(m_ctx, "JSON"));
+        ValueType arguments[1] = {value};
+        std::string string = Value::to_string(m_ctx, Object::call_method(m_ctx, json_object, "stringify", 1, arguments));
+
+        return &m_defaults.emplace(key, json::parse(string)).first->second;
+    }
+
+    // Accepts milliseconds since the epoch or ISO 8601 strings such as those JSON.stringify()
+    // produces for dates.
+    static Timestamp to_timestamp(const json &value) {
+        if (value.is_number()) {
+            return timestamp_from_milliseconds(value.get<double>());
+        }
+        if (!value.is_string()) {
+            throw std::invalid_argument("Date properties must be imported from numbers or ISO 8601 strings.");
+        }
+
+        std::string string = value.get<std::string>();
+        int year, month, day, hour, minute, consumed = 0;
+        double second;
+        if (sscanf(string.c_str(), "%d-%d-%dT%d:%d:%lf%n", &year, &month, &day, &hour, &minute, &second, &consumed) != 6) {
+            throw std::invalid_argument("Invalid date '" + string + "'.");
+        }
+
+        int offset = 0;
+        std::string zone = string.substr(consumed);
+        if (!zone.empty() && zone != "Z") {
+            char sign;
+            int offset_hours, offset_minutes;
+            if (sscanf(zone.c_str(), "%c%d:%d", &sign, &offset_hours, &offset_minutes) != 3 || (sign != '+' && sign != '-')) {
+                throw std::invalid_argument("Invalid date '" + string + "'.");
+            }
+            offset = (sign == '+' ? 1 : -1) * (offset_hours * 3600 + offset_minutes * 60);
+        }
+
+        double whole_seconds = std::floor(second);
+        int64_t seconds = days_from_civil(year, month, day) * 86400 + hour * 3600 + minute * 60 + (int64_t)whole_seconds - offset;
+        return Timestamp(seconds, (int32_t)std::round((second - whole_seconds) * 1e9));
+    }
+
+  private:
+    static const size_t chunk_size = 64 * 1024;
+
+    ContextType m_ctx;
+    SharedRealm m_realm;
+    const ObjectSchema &m_object_schema;
+    Options m_options;
+
+    size_t m_count = 0;
+    size_t m_batch_count = 0;
+    std::map<std::pair<std::string, std::string>, json> m_defaults;
+
+    template<typename Import>
+    size_t run(Import &&import) {
+        try {
+            import();
+            if (m_batch_count) {
+                commit_batch();
+            }
+        }
+        catch (...) {
+            if (m_realm->is_in_transaction()) {
+                m_realm->cancel_transaction();
+            }
+            throw;
+        }
+        return m_count;
+    }
+
+    void import_line(const std::string &line) {
+        if (line.find_first_not_of(" \t\r") != std::string::npos) {
+            import_record(json::parse(line));
+        }
+    }
+
+    void import_record(const json &record) {
+        if (!record.is_object()) {
+            throw std::invalid_argument("The JSON to import must contain objects.");
+        }
+        if (!m_realm->is_in_transaction()) {
+            m_realm->begin_transaction();
+        }
+
+        try {
+            realm::Object::create<const json *>(this, m_realm, m_object_schema, &record, m_options.update);
+        }
+        catch (std::exception &e) {
+            throw std::invalid_argument("Unable to import record " + std::to_string(m_count + 1) + ": " + e.what());
+        }
+        ++m_count;
+
+        if (++m_batch_count == m_options.batch_size) {
+            commit_batch();
+        }
+    }
+
+    void commit_batch() {
+        m_realm->commit_transaction();
+        NotificationStats::did_commit(m_realm->config().path);
+        m_batch_count = 0;
+
+        if (m_options.progress) {
+            ValueType arguments[1] = {Value::from_number(m_ctx, m_count)};
+            Function<T>::call(m_ctx, *m_options.progress, 1, arguments);
+        }
+    }
+
+    static int64_t days_from_civil(int64_t year, unsigned month, unsigned day) {
+        year -= month <= 2;
+        int64_t era = (year >= 0 ? year : year - 399) / 400;
+        unsigned year_of_era = (unsigned)(year - era * 400);
+        unsigned day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        unsigned day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+        return era * 146097 + (int64_t)day_of_era - 719468;
+    }
+};
+
+} // js
+
+// Reads property values from parsed JSON records for JSONImporter.
+template<typename T>
+class NativeAccessor<const nlohmann::json *, js::JSONImporter<T> *> {
+    using ContextType = js::JSONImporter<T> *;
+    using ValueType = const nlohmann::json *;
+    using json = nlohmann::json;
+
+  public:
+    static bool dict_has_value_for_key(ContextType, ValueType dict, const std::string &prop_name) {
+        return validated(dict, dict->is_object(), "object").count(prop_name) != 0;
+    }
+    static ValueType dict_value_for_key(ContextType, ValueType dict, const std::string &prop_name) {
+        return &validated(dict, dict->is_object(), "object").at(prop_name);
+    }
+
+    static bool has_default_value_for_property(ContextType ctx, realm::Realm *, const ObjectSchema &object_schema, const std::string &prop_name) {
+        return ctx->has_default_value(object_schema, prop_name);
+    }
+    static ValueType default_value_for_property(ContextType ctx, realm::Realm *, const ObjectSchema &object_schema, const std::string &prop_name) {
+        return ctx->default_value(object_schema, prop_name);
+    }
+
+    static std::string to_binary(ContextType, ValueType &value) {
+        std::string decoded;
+        if (!base64_decode(validated(value, value->is_string(), "base64 string").template get<std::string>(), &decoded)) {
+            throw std::invalid_argument("Data properties must be imported from base64 strings.");
+        }
+        return decoded;
+    }
+    static bool to_bool(ContextType, ValueType &value) {
+        return validated(value, value->is_boolean(), "boolean").template get<bool>();
+    }
+    static long long to_long(ContextType, ValueType &value) {
+        return validated(value, value->is_number(), "number").template get<long long>();
+    }
+    static float to_float(ContextType, ValueType &value) {
+        return validated(value, value->is_number(), "number").template get<float>();
+    }
+    static double to_double(ContextType, ValueType &value) {
+        return validated(value, value->is_number(), "number").template get<double>();
+    }
+    static std::string to_string(ContextType, ValueType &value) {
+        return validated(value, value->is_string(), "string").template get<std::string>();
+    }
+    static Timestamp to_timestamp(ContextType, ValueType &value) {
+        return js::JSONImporter<T>::to_timestamp(*value);
+    }
+
+    static bool is_null(ContextType, ValueType &value) {
+        return !value || value->is_null();
+    }
+    static ValueType null_value(ContextType) {
+        static const json null_json;
+        return &null_json;
+    }
+
+    static size_t to_object_index(ContextType ctx, SharedRealm realm, ValueType &value, const std::string &type, bool try_update) {
+        validated(value, value->is_object(), "object");
+        auto object_schema = realm->schema().find(type);
+        return realm::Object::create<ValueType>(ctx, realm, *object_schema, value, try_update).row().get_index();
+    }
+    static size_t to_existing_object_index(ContextType, SharedRealm, ValueType &) {
+        throw std::invalid_argument("Existing objects can not be referenced from imported JSON.");
+    }
+
+    static size_t list_size(ContextType, ValueType &value) {
+        return validated(value, value->is_array(), "array").size();
+    }
+    static ValueType list_value_at_index(ContextType, ValueType &value, size_t index) {
+        return &value->at(index);
+    }
+
+    static Mixed to_mixed(ContextType, ValueType &) {
+        throw std::runtime_error("'Any' type is unsupported");
+    }
+
+    // Imported values are never read back through this accessor.
+    static ValueType from_binary(ContextType, BinaryData) { throw unsupported(); }
+    static ValueType from_bool(ContextType, bool) { throw unsupported(); }
+    static ValueType from_long(ContextType, long long) { throw unsupported(); }
+    static ValueType from_float(ContextType, float) { throw unsupported(); }
+    static ValueType from_double(ContextType, double) { throw unsupported(); }
+    static ValueType from_string(ContextType, StringData) { throw unsupported(); }
+    static ValueType from_timestamp(ContextType, Timestamp) { throw unsupported(); }
+    static ValueType from_object(ContextType, realm::Object) { throw unsupported(); }
+    static ValueType from_list(ContextType, realm::List) { throw unsupported(); }
+    static ValueType from_results(ContextType, realm::Results) { throw unsupported(); }
+
+  private:
+    static const json &validated(ValueType value, bool valid, const char *type) {
+        if (!valid) {
+            throw std::invalid_argument(std::string("Imported value '") + value->dump() + "' must be of type '" + type + "'.");
+        }
+        return *value;
+    }
+    static std::logic_error unsupported() {
+        return std::logic_error("JSON values can only be read for import.");
+    }
+};
+
+} // realm
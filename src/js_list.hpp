@@ -38,7 +38,7 @@ class List : public realm::List {
     List(std::shared_ptr<realm::Realm> r, const ObjectSchema& s, LinkViewRef l) noexcept : realm::List(r, l) {}
     List(const realm::List &l) : realm::List(l) {}
     
-    std::vector<std::pair<Protected<typename T::Function>, NotificationToken>> m_notification_tokens;
+    ListenerRegistry<T> m_notification_tokens;
 };
 
 template<typename T>
@@ -96,6 +96,15 @@ struct ListClass : ClassDefinition<T, realm::js::List<T>, CollectionClass<T>> {
     };
 
     IndexPropertyType<T> const index_accessor = {wrap<get_index>, wrap<set_index>};
+
+  private:
+    // List changes are not recorded in the undo log of savepoints.
+    static void will_modify(realm::List &list) {
+        auto delegate = get_delegate<T>(list.get_realm().get());
+        if (delegate && delegate->in_savepoint()) {
+            delegate->refuse_irreversible_change("Changing lists");
+        }
+    }
 };
 
 template<typename T>
@@ -120,6 +129,7 @@ void ListClass<T>::get_index(ContextType ctx, ObjectType object, uint32_t index,
 template<typename T>
 bool ListClass<T>::set_index(ContextType ctx, ObjectType object, uint32_t index, ValueType value) {
     auto list = get_internal<T, ListClass<T>>(object);
+    will_modify(*list);
     list->set(ctx, value, index);
     return true;
 }
@@ -129,6 +139,7 @@ void ListClass<T>::push(ContextType ctx, FunctionType, ObjectType this_object, s
     validate_argument_count_at_least(argc, 1);
 
     auto list = get_internal<T, ListClass<T>>(this_object);
+    will_modify(*list);
     for (size_t i = 0; i < argc; i++) {
         list->add(ctx, arguments[i]);
     }
@@ -141,6 +152,7 @@ void ListClass<T>::pop(ContextType ctx, FunctionType, ObjectType this_object, si
     validate_argument_count(argc, 0);
 
     auto list = get_internal<T, ListClass<T>>(this_object);
+    will_modify(*list);
     size_t size = list->size();
     if (size == 0) {
         list->verify_in_transaction();
@@ -160,6 +172,7 @@ void ListClass<T>::unshift(ContextType ctx, FunctionType, ObjectType this_object
     validate_argument_count_at_least(argc, 1);
 
     auto list = get_internal<T, ListClass<T>>(this_object);
+    will_modify(*list);
     for (size_t i = 0; i < argc; i++) {
         list->insert(ctx, arguments[i], i);
     }
@@ -172,6 +185,7 @@ void ListClass<T>::shift(ContextType ctx, FunctionType, ObjectType this_object,
     validate_argument_count(argc, 0);
 
     auto list = get_internal<T, ListClass<T>>(this_object);
+    will_modify(*list);
     if (list->size() == 0) {
         list->verify_in_transaction();
         return_value.set_undefined();
@@ -189,6 +203,7 @@ void ListClass<T>::splice(ContextType ctx, FunctionType, ObjectType this_object,
     validate_argument_count_at_least(argc, 1);
 
     auto list = get_internal<T, ListClass<T>>(this_object);
+    will_modify(*list);
     size_t size = list->size();
     long index = std::min<long>(Value::to_number(ctx, arguments[0]), size);
     if (index < 0) {
@@ -251,23 +266,31 @@ void ListClass<T>::is_valid(ContextType ctx, FunctionType, ObjectType this_objec
     
 template<typename T>
 void ListClass<T>::add_listener(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
-    validate_argument_count(argc, 1);
+    validate_argument_count(argc, 1, 2);
     
     auto list = get_internal<T, ListClass<T>>(this_object);
     auto callback = Value::validated_to_function(ctx, arguments[0]);
     Protected<FunctionType> protected_callback(ctx, callback);
     Protected<ObjectType> protected_this(ctx, this_object);
     Protected<typename T::GlobalContext> protected_ctx(Context<T>::get_global_context(ctx));
+    // Realms in a migration have no delegate, so the timings of their listeners are not reported.
+    auto delegate = get_delegate<T>(list->get_realm().get());
+    std::shared_ptr<NotificationStats> stats = delegate ? delegate->m_stats : std::make_shared<NotificationStats>(list->get_realm()->config().path);
+    CollectionListenerOptions options;
+    if (argc == 2 && !Value::is_undefined(ctx, arguments[1])) {
+        options = CollectionClass<T>::parse_listener_options(ctx, arguments[1]);
+    }
 
-    auto token = list->add_notification_callback([=](CollectionChangeSet change_set, std::exception_ptr exception) {
+    auto token = list->add_notification_callback(make_listener_callback(options, [=](CollectionChangeSet change_set) {
         HANDLESCOPE
 
         ValueType arguments[2];
         arguments[0] = static_cast<ObjectType>(protected_this);
-        arguments[1] = CollectionClass<T>::create_collection_change_set(protected_ctx, change_set);
+        arguments[1] = CollectionClass<T>::create_collection_change_set(protected_ctx, change_set, options);
+        NotificationStats::CallbackTimer timer(*stats);
         Function<T>::call(protected_ctx, protected_callback, protected_this, 2, arguments);
-    });
-    list->m_notification_tokens.emplace_back(protected_callback, std::move(token));
+    }));
+    return_value.set((double)list->m_notification_tokens.add(protected_callback, std::move(token)));
 }
     
 template<typename T>
@@ -275,19 +298,13 @@ void ListClass<T>::remove_listener(ContextType ctx, FunctionType, ObjectType thi
     validate_argument_count(argc, 1);
     
     auto list = get_internal<T, ListClass<T>>(this_object);
-    auto callback = Value::validated_to_function(ctx, arguments[0]);
-    auto protected_function = Protected<FunctionType>(ctx, callback);
-
-    auto iter = list->m_notification_tokens.begin();
-    typename Protected<FunctionType>::Comparator compare;
-    while (iter != list->m_notification_tokens.end()) {
-        if(compare(iter->first, protected_function)) {
-            iter = list->m_notification_tokens.erase(iter);
-        }
-        else {
-            iter++;
-        }
+    if (Value::is_number(ctx, arguments[0])) {
+        list->m_notification_tokens.remove((typename ListenerRegistry<T>::Id)Value::to_number(ctx, arguments[0]));
+        return;
     }
+
+    auto callback = Value::validated_to_function(ctx, arguments[0]);
+    list->m_notification_tokens.remove(Protected<FunctionType>(ctx, callback));
 }
     
 template<typename T>
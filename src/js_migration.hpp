@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2016 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "column_migrator.hpp"
+#include "js_class.hpp"
+#include "js_types.hpp"
+#include "js_util.hpp"
+
+#include "object_accessor.hpp"
+#include "object_schema.hpp"
+#include "object_store.hpp"
+#include "shared_realm.hpp"
+
+namespace realm {
+namespace js {
+
+// The state of a migration in progress. The Realms are reset once the migration function has
+// returned, after which the Migration object given to it can no longer be used.
+struct Migration {
+    SharedRealm old_realm;
+    SharedRealm realm;
+    realm::Schema *schema;
+};
+
+template<typename T>
+class MigrationClass : public ClassDefinition<T, Migration> {
+    using ContextType = typename T::Context;
+    using FunctionType = typename T::Function;
+    using ObjectType = typename T::Object;
+    using ValueType = typename T::Value;
+    using String = js::String<T>;
+    using Object = js::Object<T>;
+    using Value = js::Value<T>;
+    using ReturnValue = js::ReturnValue<T>;
+    using NativeAccessor = realm::NativeAccessor<ValueType, ContextType>;
+
+  public:
+    std::string const name = "Migration";
+
+    static void rename_property(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
+    static void convert_column(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
+    static void copy_column(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
+    static void fill_default(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
+
+    MethodMap<T> const methods = {
+        {"renameProperty", wrap<rename_property>},
+        {"convertColumn", wrap<convert_column>},
+        {"copyColumn", wrap<copy_column>},
+        {"fillDefault", wrap<fill_default>},
+    };
+
+  private:
+    static Migration &validated_migration(ObjectType object) {
+        Migration &migration = *get_internal<T, MigrationClass<T>>(object);
+        if (!migration.realm) {
+            throw std::runtime_error("The migration has already completed.");
+        }
+        return migration;
+    }
+
+    static const Property &validated_property(const SharedRealm &realm, const std::string &object_type, const std::string &name, const char *type = nullptr) {
+        auto object_schema = realm->schema().find(object_type);
+        if (object_schema == realm->schema().end()) {
+            throw std::invalid_argument("Object type '" + object_type + "' not found in schema.");
+        }
+        const Property *property = object_schema->property_for_name(name);
+        if (!property) {
+            throw std::invalid_argument("Property '" + name + "' does not exist on '" + object_type + "'.");
+        }
+        if (type && string_for_property_type(property->type) != std::string(type)) {
+            throw std::invalid_argument("Property '" + object_type + "." + name + "' is of type '" + string_for_property_type(property->type) + "', not '" + type + "'.");
+        }
+        return *property;
+    }
+
+    static TableRef table_for_property(const SharedRealm &realm, const std::string &object_type, const Property &property, size_t &column) {
+        TableRef table = ObjectStore::table_for_object_type(realm->read_group(), object_type);
+        column = table->get_column_index(property.name);
+        return table;
+    }
+
+    static void copy(Migration &migration, const std::string &object_type, const Property &from, const Property &to) {
+        size_t from_column, to_column;
+        TableRef from_table = table_for_property(migration.old_realm, object_type, from, from_column);
+        TableRef to_table = table_for_property(migration.realm, object_type, to, to_column);
+        ColumnMigrator::copy(*from_table, from_column, *to_table, to_column);
+    }
+};
+
+template<typename T>
+void MigrationClass<T>::rename_property(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
+    validate_argument_count(argc, 3);
+
+    Migration &migration = validated_migration(this_object);
+    std::string object_type = Value::validated_to_string(ctx, arguments[0], "type");
+    std::string old_name = Value::validated_to_string(ctx, arguments[1], "oldName");
+    std::string new_name = Value::validated_to_string(ctx, arguments[2], "newName");
+
+    // Moves the column holding the values of the old property into place of the new one.
+    ObjectStore::rename_property(migration.realm->read_group(), *migration.schema, object_type, old_name, new_name);
+}
+
+template<typename T>
+void MigrationClass<T>::convert_column(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
+    validate_argument_count(argc, 4);
+
+    Migration &migration = validated_migration(this_object);
+    std::string object_type = Value::validated_to_string(ctx, arguments[0], "type");
+    std::string name = Value::validated_to_string(ctx, arguments[1], "property");
+    std::string from_type = Value::validated_to_string(ctx, arguments[2], "fromType");
+    std::string to_type = Value::validated_to_string(ctx, arguments[3], "toType");
+
+    auto &from = validated_property(migration.old_realm, object_type, name, from_type.c_str());
+    auto &to = validated_property(migration.realm, object_type, name, to_type.c_str());
+    copy(migration, object_type, from, to);
+}
+
+template<typename T>
+void MigrationClass<T>::copy_column(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
+    validate_argument_count(argc, 3);
+
+    Migration &migration = validated_migration(this_object);
+    std::string object_type = Value::validated_to_string(ctx, arguments[0], "type");
+    auto &from = validated_property(migration.old_realm, object_type, Value::validated_to_string(ctx, arguments[1], "fromProperty"));
+    auto &to = validated_property(migration.realm, object_type, Value::validated_to_string(ctx, arguments[2], "toProperty"));
+    if (from.type != to.type) {
+        throw std::invalid_argument("Properties of different types must be copied with convertColumn().");
+    }
+    copy(migration, object_type, from, to);
+}
+
+template<typename T>
+void MigrationClass<T>::fill_default(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
+    validate_argument_count(argc, 3);
+
+    Migration &migration = validated_migration(this_object);
+    std::string object_type = Value::validated_to_string(ctx, arguments[0], "type");
+    auto &property = validated_property(migration.realm, object_type, Value::validated_to_string(ctx, arguments[1], "property"));
+
+    size_t column;
+    TableRef table = table_for_property(migration.realm, object_type, property, column);
+
+    ValueType value = arguments[2];
+    if (Value::is_null(ctx, value) || Value::is_undefined(ctx, value)) {
+        ColumnMigrator::fill_null(*table, column);
+        return;
+    }
+
+    // The value is converted once and then written to every row.
+    switch (property.type) {
+        case PropertyType::Int:
+            ColumnMigrator::fill(*table, column, Mixed(int64_t(NativeAccessor::to_long(ctx, value))));
+            break;
+        case PropertyType::Bool:
+            ColumnMigrator::fill(*table, column, Mixed(NativeAccessor::to_bool(ctx, value)));
+            break;
+        case PropertyType::Float:
+            ColumnMigrator::fill(*table, column, Mixed(NativeAccessor::to_float(ctx, value)));
+            break;
+        case PropertyType::Double:
+            ColumnMigrator::fill(*table, column, Mixed(NativeAccessor::to_double(ctx, value)));
+            break;
+        case PropertyType::String: {
+            std::string string = NativeAccessor::to_string(ctx, value);
+            ColumnMigrator::fill(*table, column, Mixed(StringData(string)));
+            break;
+        }
+        case PropertyType::Data: {
+            std::string data = NativeAccessor::to_binary(ctx, value);
+            ColumnMigrator::fill(*table, column, Mixed(BinaryData(data)));
+            break;
+        }
+        case PropertyType::Date:
+            ColumnMigrator::fill(*table, column, Mixed(NativeAccessor::to_timestamp(ctx, value)));
+            break;
+        default:
+            throw std::invalid_argument("Property '" + object_type + "." + property.name + "' can not be filled natively.");
+    }
+}
+
+} // js
+} // realm
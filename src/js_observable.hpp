@@ -18,14 +18,80 @@
 
 #pragma once
 
+#include <atomic>
+#include <unordered_map>
+
 #include "js_class.hpp"
 
+#include "collection_notifications.hpp"
+
 namespace realm {
 namespace js {
 
 // Empty class that merely serves as useful type for now.
 class Observable {};
 
+// The notification tokens of the listeners added to a collection or object, indexed both by the
+// id returned from addListener() and by the identity of the callback, so neither kind of removal
+// has to scan the other registrations.
+template<typename T>
+class ListenerRegistry {
+    using Callback = Protected<typename T::Function>;
+
+  public:
+    using Id = uint64_t;
+
+    Id add(Callback callback, NotificationToken token) {
+        // Ids are unique across all registries so that a token passed to the wrong
+        // collection is simply not found.
+        static std::atomic<Id> s_next_id(1);
+        Id id = s_next_id++;
+
+        m_ids.emplace(callback, id);
+        m_registrations.emplace(id, Registration{std::move(callback), std::move(token)});
+        return id;
+    }
+
+    // Removes every registration of the callback.
+    void remove(const Callback &callback) {
+        auto range = m_ids.equal_range(callback);
+        for (auto iter = range.first; iter != range.second; ++iter) {
+            m_registrations.erase(iter->second);
+        }
+        m_ids.erase(range.first, range.second);
+    }
+
+    void remove(Id id) {
+        auto registration = m_registrations.find(id);
+        if (registration == m_registrations.end()) {
+            return;
+        }
+
+        auto range = m_ids.equal_range(registration->second.callback);
+        for (auto iter = range.first; iter != range.second; ++iter) {
+            if (iter->second == id) {
+                m_ids.erase(iter);
+                break;
+            }
+        }
+        m_registrations.erase(registration);
+    }
+
+    void clear() {
+        m_ids.clear();
+        m_registrations.clear();
+    }
+
+  private:
+    struct Registration {
+        Callback callback;
+        NotificationToken token;
+    };
+
+    std::unordered_multimap<Callback, Id, typename Callback::Hasher, typename Callback::Comparator> m_ids;
+    std::unordered_map<Id, Registration> m_registrations;
+};
+
 template<typename T>
 struct ObservableClass : ClassDefinition<T, Observable> {
     std::string const name = "Observable";
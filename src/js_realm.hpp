@@ -18,17 +18,32 @@
 
 #pragma once
 
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iterator>
 #include <list>
 #include <map>
+#include <memory>
+#include <thread>
+#include <unordered_set>
 
+#include "datetime_upgrade.hpp"
+#include "event_loop_dispatcher.hpp"
 #include "js_class.hpp"
 #include "js_types.hpp"
 #include "js_util.hpp"
 #include "js_realm_object.hpp"
+#include "js_realm_pool.hpp"
 #include "js_list.hpp"
 #include "js_results.hpp"
 #include "js_schema.hpp"
+#include "js_json_import.hpp"
+#include "js_migration.hpp"
 #include "js_observable.hpp"
+#include "notification_stats.hpp"
+#include "realm_file_stats.hpp"
+#include "results_exporter.hpp"
 
 #if REALM_ENABLE_SYNC
 #include "js_sync.hpp"
@@ -40,6 +55,7 @@
 #include "binding_context.hpp"
 #include "object_accessor.hpp"
 #include "platform.hpp"
+#include "thread_safe_reference.hpp"
 
 namespace realm {
 namespace js {
@@ -68,9 +84,11 @@ template<typename T>
 class RealmDelegate : public BindingContext {
   public:
     using GlobalContextType = typename T::GlobalContext;
+    using ContextType = typename T::Context;
     using FunctionType = typename T::Function;
     using ObjectType = typename T::Object;
     using ValueType = typename T::Value;
+    using Object = js::Object<T>;
     using Value = js::Value<T>;
 
     using ObjectDefaultsMap = typename Schema<T>::ObjectDefaultsMap;
@@ -78,37 +96,62 @@ class RealmDelegate : public BindingContext {
 
     virtual void did_change(std::vector<ObserverState> const& observers, std::vector<void*> const& invalidated, bool version_changed) {
         notify("change");
+        m_stats->did_notify();
+    }
+    virtual void before_notify() {
+        m_stats->will_notify();
+        notify("beforenotify");
+    }
+    virtual void schema_did_change(realm::Schema const&) {
+        notify("schema");
     }
     virtual std::vector<ObserverState> get_observed_rows() {
         return std::vector<ObserverState>();
     }
     virtual void will_change(std::vector<ObserverState> const& observers, std::vector<void*> const& invalidated) {}
 
-    RealmDelegate(std::weak_ptr<realm::Realm> realm, GlobalContextType ctx) : m_context(ctx), m_realm(realm) {}
+    RealmDelegate(std::shared_ptr<realm::Realm> realm, GlobalContextType ctx) : m_stats(std::make_shared<NotificationStats>(realm->config().path)), m_context(ctx), m_realm(realm) {}
 
     ~RealmDelegate() {
         // All protected values need to be unprotected while the context is retained.
         m_defaults.clear();
         m_constructors.clear();
         m_notifications.clear();
+        m_async_evaluations.clear();
     }
 
-    void add_notification(FunctionType notification) {
-        for (auto &handler : m_notifications) {
-            if (handler == notification) {
-                return;
-            }
+    void add_notification(const std::string &name, FunctionType notification) {
+        auto &event = m_notifications[name];
+        Protected<FunctionType> callback(m_context, notification);
+        if (!event.registered.insert(callback).second) {
+            return;
         }
-        m_notifications.emplace_back(m_context, notification);
+        event.mutable_callbacks().push_back(std::move(callback));
     }
-    void remove_notification(FunctionType notification) {
-        for (auto iter = m_notifications.begin(); iter != m_notifications.end(); ++iter) {
-            if (*iter == notification) {
-                m_notifications.erase(iter);
-                return;
+    void remove_notification(const std::string &name, FunctionType notification) {
+        auto iter = m_notifications.find(name);
+        if (iter == m_notifications.end()) {
+            return;
+        }
+
+        auto &event = iter->second;
+        Protected<FunctionType> callback(m_context, notification);
+        if (!event.registered.erase(callback)) {
+            return;
+        }
+
+        auto &callbacks = event.mutable_callbacks();
+        typename Protected<FunctionType>::Comparator compare;
+        for (auto handler = callbacks.begin(); handler != callbacks.end(); ++handler) {
+            if (compare(*handler, callback)) {
+                callbacks.erase(handler);
+                break;
             }
         }
     }
+    void remove_all_notifications(const std::string &name) {
+        m_notifications.erase(name);
+    }
     void remove_all_notifications() {
         m_notifications.clear();
     }
@@ -116,26 +159,192 @@ class RealmDelegate : public BindingContext {
     ObjectDefaultsMap m_defaults;
     ConstructorMap m_constructors;
 
+    // Savepoints record enough to undo the changes made since they were created: the size of
+    // each table, since new objects are always appended, and the previous values of properties
+    // set on existing objects. Changes which can not be undone this way are refused while a
+    // savepoint is active, so a savepoint can always be rolled back.
+    struct Savepoint {
+        std::vector<size_t> table_sizes;
+        std::vector<std::function<void()>> undo_log;
+    };
+
+    void begin_savepoint(Group &group) {
+        Savepoint savepoint;
+        savepoint.table_sizes.reserve(group.size());
+        for (size_t i = 0; i < group.size(); ++i) {
+            savepoint.table_sizes.push_back(group.get_table(i)->size());
+        }
+        m_savepoints.push_back(std::move(savepoint));
+    }
+
+    void release_savepoint() {
+        Savepoint savepoint = std::move(m_savepoints.back());
+        m_savepoints.pop_back();
+
+        if (!m_savepoints.empty()) {
+            auto &outer = m_savepoints.back();
+            std::move(savepoint.undo_log.begin(), savepoint.undo_log.end(), std::back_inserter(outer.undo_log));
+        }
+    }
+
+    void rollback_savepoint(Group &group) {
+        Savepoint savepoint = std::move(m_savepoints.back());
+        m_savepoints.pop_back();
+
+        for (auto undo = savepoint.undo_log.rbegin(); undo != savepoint.undo_log.rend(); ++undo) {
+            (*undo)();
+        }
+        for (size_t i = 0; i < savepoint.table_sizes.size(); ++i) {
+            TableRef table = group.get_table(i);
+            while (table->size() > savepoint.table_sizes[i]) {
+                table->move_last_over(table->size() - 1);
+            }
+        }
+    }
+
+    bool in_savepoint() const {
+        return !m_savepoints.empty();
+    }
+
+    // Called before a property of the object is set while a savepoint is active.
+    void will_set_property(ContextType ctx, realm::Object &object, const Property &property) {
+        if (created_since_savepoint(object.row())) {
+            return;
+        }
+        if (property.type == PropertyType::Array) {
+            refuse_irreversible_change("Setting lists of objects which existed before the savepoint");
+        }
+
+        realm::Object realm_object(object);
+        std::string name = property.name;
+        Protected<ValueType> old_value(ctx, realm_object.template get_property_value<ValueType>(ctx, name));
+        m_savepoints.back().undo_log.push_back([=]() mutable {
+            ContextType ctx = m_context;
+            realm_object.set_property_value(ctx, name, static_cast<ValueType>(old_value), true);
+        });
+    }
+
+    // Called before create() updates the existing object with the primary key given in
+    // 'properties' while a savepoint is active.
+    void will_update(ContextType ctx, SharedRealm realm, const ObjectSchema &object_schema, ObjectType properties) {
+        // Linked objects given as values are updated by their primary key as well.
+        for (auto &property : object_schema.persisted_properties) {
+            if (property.type != PropertyType::Object && property.type != PropertyType::Array) {
+                continue;
+            }
+            ValueType value = Object::get_property(ctx, properties, property.name);
+            if (Value::is_undefined(ctx, value) || Value::is_null(ctx, value)) {
+                continue;
+            }
+            auto target = realm->schema().find(property.object_type);
+            if (target != realm->schema().end() && target->primary_key_property()) {
+                refuse_irreversible_change("Updating linked objects by primary key");
+            }
+        }
+
+        const Property *primary_key = object_schema.primary_key_property();
+        if (!primary_key) {
+            return;
+        }
+        ValueType primary_value = Object::get_property(ctx, properties, primary_key->name);
+        if (Value::is_undefined(ctx, primary_value)) {
+            return;
+        }
+
+        auto object = realm::Object::get_for_primary_key(ctx, realm, object_schema, primary_value);
+        if (!object.is_valid()) {
+            return;
+        }
+        for (auto &property : object_schema.persisted_properties) {
+            if (&property != primary_key && !Value::is_undefined(ctx, Object::get_property(ctx, properties, property.name))) {
+                will_set_property(ctx, object, property);
+            }
+        }
+    }
+
+    // Called before changes which the undo log can not record while a savepoint is active.
+    // These are refused before anything is changed, so the savepoint can still be rolled back.
+    void refuse_irreversible_change(const std::string &change) {
+        throw std::runtime_error(change + " can not be undone, so it is not allowed within a savepoint.");
+    }
+    void will_delete(const Row &row) {
+        if (!created_since_savepoint(row)) {
+            refuse_irreversible_change("Deleting objects which existed before the savepoint");
+        }
+    }
+
+    // Shared with the collection and object listeners of this Realm, which outlive the delegate.
+    std::shared_ptr<NotificationStats> m_stats;
+
+    // The tokens of Results.evaluateAsync() calls which have not been delivered yet. Their
+    // callbacks only hold weak references to them, so they are released when the Realm is closed.
+    std::list<std::shared_ptr<NotificationToken>> m_async_evaluations;
+
   private:
+    using CallbackList = std::vector<Protected<FunctionType>>;
+
+    // Set while the callback of write() runs, truncate() is only allowed within it.
+    bool m_in_write = false;
+
+    // Set by truncate() until the write transaction ends, so that "reset" is only sent once
+    // the cleared tables have been committed.
+    bool m_truncated = false;
+    bool m_compact_after_commit = false;
+
+    struct NotificationEvent {
+        std::shared_ptr<CallbackList> callbacks = std::make_shared<CallbackList>();
+        std::unordered_set<Protected<FunctionType>, typename Protected<FunctionType>::Hasher, typename Protected<FunctionType>::Comparator> registered;
+        std::unique_ptr<Protected<ValueType>> name;
+
+        // notify() holds on to the list while calling the listeners, so it is only copied when
+        // a listener adds or removes listeners of the same event.
+        CallbackList &mutable_callbacks() {
+            if (callbacks.use_count() > 1) {
+                callbacks = std::make_shared<CallbackList>(*callbacks);
+            }
+            return *callbacks;
+        }
+    };
+
     Protected<GlobalContextType> m_context;
-    std::list<Protected<FunctionType>> m_notifications;
+    std::map<std::string, NotificationEvent> m_notifications;
     std::weak_ptr<realm::Realm> m_realm;
 
+    std::vector<Savepoint> m_savepoints;
+
+    bool created_since_savepoint(const Row &row) const {
+        auto &table_sizes = m_savepoints.back().table_sizes;
+        size_t table_index = row.get_table()->get_index_in_group();
+        return table_index >= table_sizes.size() || row.get_index() >= table_sizes[table_index];
+    }
+
     void notify(const char *notification_name) {
+        auto iter = m_notifications.find(notification_name);
+        if (iter == m_notifications.end() || iter->second.callbacks->empty()) {
+            return;
+        }
+
         HANDLESCOPE
 
+        auto &event = iter->second;
+        std::shared_ptr<const CallbackList> callbacks = event.callbacks;
+
+        // The Realm object is not kept between notifications, since it would keep the Realm alive.
         SharedRealm realm = m_realm.lock();
         if (!realm) {
             throw std::runtime_error("Realm no longer exists");
         }
+        if (!event.name) {
+            event.name.reset(new Protected<ValueType>(m_context, Value::from_string(m_context, notification_name)));
+        }
 
         ObjectType realm_object = create_object<T, RealmClass<T>>(m_context, new SharedRealm(realm));
         ValueType arguments[2];
         arguments[0] = realm_object;
-        arguments[1] = Value::from_string(m_context, notification_name);
+        arguments[1] = *event.name;
 
-        std::list<Protected<FunctionType>> notifications_copy(m_notifications);
-        for (auto &callback : notifications_copy) {
+        for (auto &callback : *callbacks) {
+            NotificationStats::CallbackTimer timer(*m_stats);
             Function<T>::call(m_context, callback, realm_object, 2, arguments);
         }
     }
@@ -173,10 +382,17 @@ public:
     static void create(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
     static void delete_one(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
     static void delete_all(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
+    static void truncate(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
     static void write(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
+    static void savepoint(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
     static void add_listener(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
     static void remove_listener(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
     static void remove_all_listeners(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
+    static void get_notification_stats(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
+    static void export_to(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
+    static void write_copy_to(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
+    static void compact(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
+    static void get_file_stats(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
     static void close(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
 
     // properties
@@ -184,6 +400,7 @@ public:
     static void get_schema_version(ContextType, ObjectType, ReturnValue &);
     static void get_schema(ContextType, ObjectType, ReturnValue &);
     static void get_read_only(ContextType, ObjectType, ReturnValue &);
+    static void get_in_memory(ContextType, ObjectType, ReturnValue &);
 #if REALM_ENABLE_SYNC
     static void get_sync_session(ContextType, ObjectType, ReturnValue &);
 #endif
@@ -195,6 +412,8 @@ public:
     static void schema_version(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
     static void clear_test_state(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
     static void copy_bundled_realm_files(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
+    static void import_json(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
+    static void prepare_open(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
 
     // static properties
     static void get_default_path(ContextType, ObjectType, ReturnValue &);
@@ -206,6 +425,8 @@ public:
         {"schemaVersion", wrap<schema_version>},
         {"clearTestState", wrap<clear_test_state>},
         {"copyBundledRealmFiles", wrap<copy_bundled_realm_files>},
+        {"importJSON", wrap<import_json>},
+        {"_prepareOpen", wrap<prepare_open>},
     };
 
     PropertyMap<T> const static_properties = {
@@ -218,10 +439,17 @@ public:
         {"create", wrap<create>},
         {"delete", wrap<delete_one>},
         {"deleteAll", wrap<delete_all>},
+        {"truncate", wrap<truncate>},
         {"write", wrap<write>},
+        {"savepoint", wrap<savepoint>},
         {"addListener", wrap<add_listener>},
         {"removeListener", wrap<remove_listener>},
         {"removeAllListeners", wrap<remove_all_listeners>},
+        {"getNotificationStats", wrap<get_notification_stats>},
+        {"_exportTo", wrap<export_to>},
+        {"_writeCopyTo", wrap<write_copy_to>},
+        {"compact", wrap<compact>},
+        {"getFileStats", wrap<get_file_stats>},
         {"close", wrap<close>},
     };
 
@@ -230,16 +458,115 @@ public:
         {"schemaVersion", {wrap<get_schema_version>, nullptr}},
         {"schema", {wrap<get_schema>, nullptr}},
         {"readOnly", {wrap<get_read_only>, nullptr}},
+        {"inMemory", {wrap<get_in_memory>, nullptr}},
 #if REALM_ENABLE_SYNC
         {"syncSession", {wrap<get_sync_session>, nullptr}},
 #endif
     };
 
   private:
+    friend class RealmPoolClass<T>;
+
+    // The options of a Realm configuration, of which only `config` is used by the object store.
+    struct ParsedConfig {
+        realm::Realm::Config config;
+        ObjectDefaultsMap defaults;
+        ConstructorMap constructors;
+        bool schema_updated = false;
+        util::Optional<double> group_commit_ms, group_commit_max;
+        util::Optional<FunctionType> should_compact_on_launch;
+        util::Optional<FunctionType> upgrade_progress;
+    };
+
+    static ParsedConfig parse_config(ContextType, size_t, const ValueType[]);
+
+    // Group commit settings are kept on the Realm object created with the config, since other
+    // Realm objects for the same file share its RealmDelegate.
+    static void set_group_commit_properties(ContextType ctx, ObjectType object, util::Optional<double> group_commit_ms, util::Optional<double> group_commit_max) {
+        PropertyAttributes attributes = ReadOnly | DontEnum | DontDelete;
+        Object::set_property(ctx, object, "groupCommitMs", Value::from_number(ctx, group_commit_ms.value_or(0)), attributes);
+        Object::set_property(ctx, object, "groupCommitMax", Value::from_number(ctx, group_commit_max.value_or(0)), attributes);
+    }
+
+    // A copy of the configuration of a Realm which can be opened on another thread.
+    static realm::Realm::Config background_config(realm::Realm::Config config) {
+        config.cache = false;
+        config.execution_context = util::none;
+        // The migration function holds on to JS values.
+        config.migration_function = nullptr;
+        return config;
+    }
+
+    // Runs `work` on a background thread, then calls `done` on the JS thread with the message of
+    // the exception thrown by `work`, or an empty string if it succeeded.
+    static void dispatch_to_background(std::function<void()> work, std::function<void(std::string)> done) {
+        auto complete = std::make_shared<EventLoopDispatcher<void(std::string)>>(std::move(done));
+        std::thread([=]() {
+            try {
+                work();
+                (*complete)(std::string());
+            }
+            catch (std::exception &e) {
+                (*complete)(e.what());
+            }
+        }).detach();
+    }
+
+    // Named numbers reported to the callback of work done by the binding, in the order given.
+    using WorkStats = std::vector<std::pair<std::string, double>>;
+
+    static WorkStats export_stats(const ResultsExporter::Stats &stats) {
+        return {{"rows", (double)stats.rows}, {"seconds", stats.seconds}, {"rowsPerSecond", stats.seconds > 0 ? stats.rows / stats.seconds : 0}};
+    }
+
+    // Group::write() only writes the objects of the current version, so the copy is always compacted.
+    static WorkStats write_copy(realm::Realm &realm, const std::string &path, const std::vector<char> &encryption_key) {
+        auto start = std::chrono::steady_clock::now();
+        realm.read_group().write(path, encryption_key.empty() ? nullptr : encryption_key.data());
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        std::ifstream file(path, std::ios::in | std::ios::binary | std::ios::ate);
+        return {{"bytes", (double)file.tellg()}, {"seconds", elapsed.count()}};
+    }
+
+    static ObjectType create_stats_object(ContextType ctx, const WorkStats &stats) {
+        ObjectType object = Object::create_empty(ctx);
+        for (auto &stat : stats) {
+            Object::set_property(ctx, object, stat.first, Value::from_number(ctx, stat.second));
+        }
+        return object;
+    }
+
+    // Calls `work` with a separate instance of the Realm on a background thread, then calls
+    // `callback` on the JS thread with either an error message or the stats returned by `work`.
+    static void run_in_background(ContextType ctx, const SharedRealm &realm, FunctionType callback, std::function<WorkStats(SharedRealm)> work) {
+        Protected<FunctionType> protected_callback(ctx, callback);
+        Protected<typename T::GlobalContext> protected_ctx(Context<T>::get_global_context(ctx));
+        auto stats = std::make_shared<WorkStats>();
+        realm::Realm::Config config = background_config(realm->config());
+
+        dispatch_to_background([=]() {
+            *stats = work(realm::Realm::get_shared_realm(config));
+        }, [=](std::string error) {
+            HANDLESCOPE
+
+            ValueType callback_arguments[2];
+            if (error.empty()) {
+                callback_arguments[0] = Value::from_undefined(protected_ctx);
+                callback_arguments[1] = create_stats_object(protected_ctx, *stats);
+            }
+            else {
+                callback_arguments[0] = Value::from_string(protected_ctx, error);
+                callback_arguments[1] = Value::from_undefined(protected_ctx);
+            }
+            Function::call(protected_ctx, protected_callback, 2, callback_arguments);
+        });
+    }
+
     static std::string validated_notification_name(ContextType ctx, const ValueType &value) {
         std::string name = Value::validated_to_string(ctx, value, "notification name");
-        if (name != "change") {
-            throw std::runtime_error("Only the 'change' notification name is supported.");
+        if (name != "change" && name != "beforenotify" && name != "schema" && name != "reset") {
+            throw std::runtime_error("Only the 'change', 'beforenotify', 'schema' and 'reset' notification names are supported.");
         }
         return name;
     }
@@ -279,17 +606,24 @@ public:
 
 template<typename T>
 inline typename T::Function RealmClass<T>::create_constructor(ContextType ctx) {
+    // Parsed schemas hold on to values of any previous context.
+    Schema<T>::clear_cache();
+
     FunctionType realm_constructor = ObjectWrap<T, RealmClass<T>>::create_constructor(ctx);
     FunctionType collection_constructor = ObjectWrap<T, CollectionClass<T>>::create_constructor(ctx);
     FunctionType list_constructor = ObjectWrap<T, ListClass<T>>::create_constructor(ctx);
     FunctionType results_constructor = ObjectWrap<T, ResultsClass<T>>::create_constructor(ctx);
     FunctionType realm_object_constructor = ObjectWrap<T, RealmObjectClass<T>>::create_constructor(ctx);
+    FunctionType pool_constructor = ObjectWrap<T, RealmPoolClass<T>>::create_constructor(ctx);
+    FunctionType migration_constructor = ObjectWrap<T, MigrationClass<T>>::create_constructor(ctx);
 
     PropertyAttributes attributes = ReadOnly | DontEnum | DontDelete;
     Object::set_property(ctx, realm_constructor, "Collection", collection_constructor, attributes);
     Object::set_property(ctx, realm_constructor, "List", list_constructor, attributes);
     Object::set_property(ctx, realm_constructor, "Results", results_constructor, attributes);
     Object::set_property(ctx, realm_constructor, "Object", realm_object_constructor, attributes);
+    Object::set_property(ctx, realm_constructor, "Pool", pool_constructor, attributes);
+    Object::set_property(ctx, realm_constructor, "Migration", migration_constructor, attributes);
 
 #if REALM_ENABLE_SYNC
     FunctionType sync_constructor = SyncClass<T>::create_constructor(ctx);
@@ -300,48 +634,65 @@ inline typename T::Function RealmClass<T>::create_constructor(ContextType ctx) {
     return realm_constructor;
 }
 
-static inline void convert_outdated_datetime_columns(const SharedRealm &realm) {
-    realm::util::Optional<int> old_file_format_version = realm->file_format_upgraded_from_version();
-    if (old_file_format_version && old_file_format_version < 5) {
-        // any versions earlier than file format 5 are stored as milliseconds and need to be converted to the new format
-        for (auto& object_schema : realm->schema()) {
-            auto table = ObjectStore::table_for_object_type(realm->read_group(), object_schema.name);
-            for (auto& property : object_schema.persisted_properties) {
-                if (property.type == realm::PropertyType::Date) {
-                    if (!realm->is_in_transaction()) {
-                        realm->begin_transaction();
-                    }
+static inline void convert_outdated_datetime_columns(const SharedRealm &realm, const DatetimeUpgrade::ProgressHandler &progress = nullptr) {
+    // any versions earlier than file format 5 are stored as milliseconds and need to be converted to the new format
+    DatetimeUpgrade(realm).run(progress);
+}
 
-                    for (size_t row_index = 0; row_index < table->size(); row_index++) {
-                        if (table->is_null(property.table_column, row_index)) {
-                            continue;
-                        }
-                        auto milliseconds = table->get_timestamp(property.table_column, row_index).get_seconds();
-                        table->set_timestamp(property.table_column, row_index, Timestamp(milliseconds / 1000, (milliseconds % 1000) * 1000000));
-                    }
-                }
-            }
-            if (realm->is_in_transaction()) {
-                realm->commit_transaction();
+template<typename T>
+void RealmClass<T>::constructor(ContextType ctx, ObjectType this_object, size_t argc, const ValueType arguments[]) {
+    ParsedConfig parsed = parse_config(ctx, argc, arguments);
+    realm::Realm::Config &config = parsed.config;
+    ensure_directory_exists_for_file(config.path);
+
+    // Compaction only succeeds if the file is not open yet, so this has to happen before the
+    // Realm is opened. The callback is not called for new files, nor for files which have to be
+    // upgraded to the current file format first.
+    if (parsed.should_compact_on_launch && RealmFileSession::exists(config)) {
+        std::unique_ptr<RealmFileSession> session;
+        try {
+            session.reset(new RealmFileSession(config));
+        }
+        catch (FileFormatUpgradeRequired const&) {}
+
+        if (session) {
+            auto stats = session->stats();
+            ValueType arguments[2] = {Value::from_number(ctx, stats.total_bytes), Value::from_number(ctx, stats.used_bytes)};
+            ValueType should_compact = Function::call(ctx, *parsed.should_compact_on_launch, 2, arguments);
+            if (Value::validated_to_boolean(ctx, should_compact, "return value of shouldCompactOnLaunch")) {
+                session->compact();
             }
         }
     }
+
+    auto realm = create_shared_realm(ctx, config, parsed.schema_updated, std::move(parsed.defaults), std::move(parsed.constructors));
+
+    // Fix for datetime -> timestamp conversion
+    DatetimeUpgrade::ProgressHandler progress;
+    if (parsed.upgrade_progress) {
+        FunctionType upgrade_progress = *parsed.upgrade_progress;
+        progress = [=](size_t converted, size_t total) {
+            ValueType arguments[2] = {Value::from_number(ctx, converted), Value::from_number(ctx, total)};
+            Function::call(ctx, upgrade_progress, 2, arguments);
+        };
+    }
+    convert_outdated_datetime_columns(realm, progress);
+
+    set_internal<T, RealmClass<T>>(this_object, new SharedRealm(realm));
+    set_group_commit_properties(ctx, this_object, parsed.group_commit_ms, parsed.group_commit_max);
 }
 
 template<typename T>
-void RealmClass<T>::constructor(ContextType ctx, ObjectType this_object, size_t argc, const ValueType arguments[]) {
-    realm::Realm::Config config;
-    ObjectDefaultsMap defaults;
-    ConstructorMap constructors;
-    bool schema_updated = false;
+typename RealmClass<T>::ParsedConfig RealmClass<T>::parse_config(ContextType ctx, size_t argc, const ValueType arguments[]) {
+    ParsedConfig parsed;
 
     if (argc == 0) {
-        config.path = default_path();
+        parsed.config.path = default_path();
     }
     else if (argc == 1) {
         ValueType value = arguments[0];
         if (Value::is_string(ctx, value)) {
-            config.path = Value::validated_to_string(ctx, value, "path");
+            parsed.config.path = Value::validated_to_string(ctx, value, "path");
         }
         else if (Value::is_object(ctx, value)) {
             ObjectType object = Value::validated_to_object(ctx, value);
@@ -350,87 +701,142 @@ void RealmClass<T>::constructor(ContextType ctx, ObjectType this_object, size_t
             ValueType encryption_key_value = Object::get_property(ctx, object, encryption_key_string);
             if (!Value::is_undefined(ctx, encryption_key_value)) {
                 std::string encryption_key = NativeAccessor::to_binary(ctx, encryption_key_value);
-                config.encryption_key = std::vector<char>(encryption_key.begin(), encryption_key.end());
+                parsed.config.encryption_key = std::vector<char>(encryption_key.begin(), encryption_key.end());
             }
 
 #if REALM_ENABLE_SYNC
-            SyncClass<T>::populate_sync_config(ctx, Value::validated_to_object(ctx, Object::get_global(ctx, "Realm")), object, config);
+            SyncClass<T>::populate_sync_config(ctx, Value::validated_to_object(ctx, Object::get_global(ctx, "Realm")), object, parsed.config);
 #endif
 
             static const String path_string = "path";
             ValueType path_value = Object::get_property(ctx, object, path_string);
             if (!Value::is_undefined(ctx, path_value)) {
-                config.path = Value::validated_to_string(ctx, path_value, "path");
+                parsed.config.path = Value::validated_to_string(ctx, path_value, "path");
             }
-            else if (config.path.empty()) {
-                config.path = js::default_path();
+            else if (parsed.config.path.empty()) {
+                parsed.config.path = js::default_path();
             }
 
             static const String read_only_string = "readOnly";
             ValueType read_only_value = Object::get_property(ctx, object, read_only_string);
             if (!Value::is_undefined(ctx, read_only_value) && Value::validated_to_boolean(ctx, read_only_value, "readOnly")) {
-                config.schema_mode = SchemaMode::ReadOnly;
+                parsed.config.schema_mode = SchemaMode::ReadOnly;
+            }
+
+            static const String in_memory_string = "inMemory";
+            ValueType in_memory_value = Object::get_property(ctx, object, in_memory_string);
+            if (!Value::is_undefined(ctx, in_memory_value)) {
+                parsed.config.in_memory = Value::validated_to_boolean(ctx, in_memory_value, "inMemory");
+            }
+
+            static const String durability_string = "durability";
+            ValueType durability_value = Object::get_property(ctx, object, durability_string);
+            if (!Value::is_undefined(ctx, durability_value)) {
+                std::string durability = Value::validated_to_string(ctx, durability_value, "durability");
+                if (durability == "async") {
+                    throw std::invalid_argument("The 'async' durability is not supported.");
+                }
+                if (durability != "full" && durability != "memory") {
+                    throw std::invalid_argument("durability must be 'full' or 'memory'.");
+                }
+                if (!Value::is_undefined(ctx, in_memory_value) && parsed.config.in_memory != (durability == "memory")) {
+                    throw std::invalid_argument("inMemory conflicts with the durability '" + durability + "'.");
+                }
+                parsed.config.in_memory = durability == "memory";
             }
 
             static const String schema_string = "schema";
             ValueType schema_value = Object::get_property(ctx, object, schema_string);
             if (!Value::is_undefined(ctx, schema_value)) {
                 ObjectType schema_object = Value::validated_to_object(ctx, schema_value, "schema");
-                config.schema.emplace(Schema<T>::parse_schema(ctx, schema_object, defaults, constructors));
-                schema_updated = true;
+                auto parsed_schema = Schema<T>::parse_cached_schema(ctx, schema_object);
+                parsed.config.schema.emplace(parsed_schema->schema);
+                parsed.defaults = parsed_schema->defaults;
+                parsed.constructors = parsed_schema->constructors;
+                parsed.schema_updated = true;
             }
 
             static const String schema_version_string = "schemaVersion";
             ValueType version_value = Object::get_property(ctx, object, schema_version_string);
             if (!Value::is_undefined(ctx, version_value)) {
-                config.schema_version = Value::validated_to_number(ctx, version_value, "schemaVersion");
+                parsed.config.schema_version = Value::validated_to_number(ctx, version_value, "schemaVersion");
             }
-            else if (schema_updated) {
-                config.schema_version = 0;
+            else if (parsed.schema_updated) {
+                parsed.config.schema_version = 0;
             }
 
             static const String migration_string = "migration";
             ValueType migration_value = Object::get_property(ctx, object, migration_string);
             if (!Value::is_undefined(ctx, migration_value)) {
                 FunctionType migration_function = Value::validated_to_function(ctx, migration_value, "migration");
-                config.migration_function = [=](SharedRealm old_realm, SharedRealm realm, realm::Schema&) {
+                parsed.config.migration_function = [=](SharedRealm old_realm, SharedRealm realm, realm::Schema& schema) {
                     auto old_realm_ptr = new SharedRealm(old_realm);
                     auto realm_ptr = new SharedRealm(realm);
-                    ValueType arguments[2] = {
+                    auto migration_ptr = new Migration{old_realm, realm, &schema};
+                    ValueType arguments[3] = {
                         create_object<T, RealmClass<T>>(ctx, old_realm_ptr),
-                        create_object<T, RealmClass<T>>(ctx, realm_ptr)
+                        create_object<T, RealmClass<T>>(ctx, realm_ptr),
+                        create_object<T, MigrationClass<T>>(ctx, migration_ptr)
                     };
 
                     try {
-                        Function<T>::call(ctx, migration_function, 2, arguments);
+                        Function<T>::call(ctx, migration_function, 3, arguments);
                     }
                     catch (...) {
                         old_realm->close();
                         old_realm_ptr->reset();
                         realm_ptr->reset();
+                        *migration_ptr = Migration{};
                         throw;
                     }
 
                     old_realm->close();
                     old_realm_ptr->reset();
                     realm_ptr->reset();
+                    *migration_ptr = Migration{};
                 };
             }
+
+            static const String group_commit_ms_string = "groupCommitMs";
+            ValueType group_commit_ms_value = Object::get_property(ctx, object, group_commit_ms_string);
+            if (!Value::is_undefined(ctx, group_commit_ms_value)) {
+                parsed.group_commit_ms = Value::validated_to_number(ctx, group_commit_ms_value, "groupCommitMs");
+                if (*parsed.group_commit_ms < 0) {
+                    throw std::invalid_argument("groupCommitMs must not be negative.");
+                }
+            }
+
+            static const String group_commit_max_string = "groupCommitMax";
+            ValueType group_commit_max_value = Object::get_property(ctx, object, group_commit_max_string);
+            if (!Value::is_undefined(ctx, group_commit_max_value)) {
+                parsed.group_commit_max = Value::validated_to_number(ctx, group_commit_max_value, "groupCommitMax");
+                if (*parsed.group_commit_max < 0) {
+                    throw std::invalid_argument("groupCommitMax must not be negative.");
+                }
+            }
+
+            static const String upgrade_progress_string = "upgradeProgress";
+            ValueType upgrade_progress_value = Object::get_property(ctx, object, upgrade_progress_string);
+            if (!Value::is_undefined(ctx, upgrade_progress_value)) {
+                parsed.upgrade_progress = Value::validated_to_function(ctx, upgrade_progress_value, "upgradeProgress");
+            }
+
+            static const String should_compact_on_launch_string = "shouldCompactOnLaunch";
+            ValueType should_compact_on_launch_value = Object::get_property(ctx, object, should_compact_on_launch_string);
+            if (!Value::is_undefined(ctx, should_compact_on_launch_value)) {
+                if (parsed.config.schema_mode == SchemaMode::ReadOnly) {
+                    throw std::invalid_argument("shouldCompactOnLaunch can not be used with readOnly.");
+                }
+                parsed.should_compact_on_launch = Value::validated_to_function(ctx, should_compact_on_launch_value, "shouldCompactOnLaunch");
+            }
         }
     }
     else {
         throw std::runtime_error("Invalid arguments when constructing 'Realm'");
     }
 
-    config.path = normalize_realm_path(config.path);
-    ensure_directory_exists_for_file(config.path);
-
-    auto realm = create_shared_realm(ctx, config, schema_updated, std::move(defaults), std::move(constructors));
-
-    // Fix for datetime -> timestamp conversion
-    convert_outdated_datetime_columns(realm);
-
-    set_internal<T, RealmClass<T>>(this_object, new SharedRealm(realm));
+    parsed.config.path = normalize_realm_path(parsed.config.path);
+    return parsed;
 }
 
 template<typename T>
@@ -458,6 +864,174 @@ SharedRealm RealmClass<T>::create_shared_realm(ContextType ctx, realm::Realm::Co
     return realm;
 }
 
+template<typename T>
+void RealmClass<T>::prepare_open(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
+    validate_argument_count(argc, 2);
+
+    ParsedConfig parsed = parse_config(ctx, 1, arguments);
+    FunctionType callback = Value::validated_to_function(ctx, arguments[1], "callback");
+
+    Protected<FunctionType> protected_callback(ctx, callback);
+    Protected<typename T::GlobalContext> protected_ctx(Context<T>::get_global_context(ctx));
+    realm::Realm::Config config = background_config(parsed.config);
+    bool has_migration_function = bool(parsed.config.migration_function);
+
+    DatetimeUpgrade::ProgressHandler progress;
+    if (parsed.upgrade_progress) {
+        Protected<FunctionType> upgrade_progress(ctx, *parsed.upgrade_progress);
+        progress = EventLoopDispatcher<void(size_t, size_t)>([=](size_t converted, size_t total) {
+            HANDLESCOPE
+
+            ValueType arguments[2] = {Value::from_number(protected_ctx, converted), Value::from_number(protected_ctx, total)};
+            Function::call(protected_ctx, upgrade_progress, 2, arguments);
+        });
+    }
+
+    auto done = [=](std::string error) {
+        HANDLESCOPE
+
+        ValueType arguments[1] = {error.empty() ? Value::from_undefined(protected_ctx) : Value::from_string(protected_ctx, error)};
+        Function::call(protected_ctx, protected_callback, 1, arguments);
+    };
+
+    // Opening the Realm once on a background thread applies the schema and upgrades the file,
+    // so opening it again on the JS thread afterwards is fast.
+    auto open = [=](bool compact) {
+        dispatch_to_background([=]() {
+            ensure_directory_exists_for_file(config.path);
+            if (compact) {
+                RealmFileSession(config).compact();
+            }
+
+            // Migration functions have to run on the JS thread.
+            if (has_migration_function) {
+                auto version = realm::Realm::get_schema_version(config);
+                if (version != ObjectStore::NotVersioned && version < config.schema_version) {
+                    return;
+                }
+            }
+
+            SharedRealm realm = realm::Realm::get_shared_realm(config);
+            convert_outdated_datetime_columns(realm, progress);
+            realm->close();
+        }, done);
+    };
+
+    if (!parsed.should_compact_on_launch) {
+        open(false);
+        return;
+    }
+
+    // The file is measured on the background thread, but whether to compact it is decided on the JS thread.
+    Protected<FunctionType> should_compact_on_launch(ctx, *parsed.should_compact_on_launch);
+    auto stats = std::make_shared<util::Optional<RealmFileSession::Stats>>();
+    dispatch_to_background([=]() {
+        if (RealmFileSession::exists(config)) {
+            try {
+                *stats = RealmFileSession(config).stats();
+            }
+            catch (FileFormatUpgradeRequired const&) {
+                // The file is upgraded and its dates converted by opening it, and not compacted.
+            }
+        }
+    }, [=](std::string error) {
+        if (!error.empty()) {
+            done(error);
+            return;
+        }
+        if (!*stats) {
+            open(false);
+            return;
+        }
+
+        HANDLESCOPE
+
+        bool compact;
+        try {
+            ValueType arguments[2] = {Value::from_number(protected_ctx, (*stats)->total_bytes), Value::from_number(protected_ctx, (*stats)->used_bytes)};
+            ValueType should_compact = Function::call(protected_ctx, should_compact_on_launch, 2, arguments);
+            compact = Value::validated_to_boolean(protected_ctx, should_compact, "return value of shouldCompactOnLaunch");
+        }
+        catch (std::exception &e) {
+            done(e.what());
+            return;
+        }
+        open(compact);
+    });
+}
+
+template<typename T>
+void RealmClass<T>::import_json(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
+    validate_argument_count(argc, 3, 4);
+
+    ObjectType realm_object = Value::validated_to_object(ctx, arguments[0], "realm");
+    if (!Object::template is_instance<RealmClass<T>>(ctx, realm_object)) {
+        throw std::invalid_argument("The first argument to importJSON must be a Realm.");
+    }
+    SharedRealm realm = *get_internal<T, RealmClass<T>>(realm_object);
+    if (realm->is_in_transaction()) {
+        throw std::runtime_error("Can not import JSON within a write transaction.");
+    }
+
+    std::string object_type;
+    auto &object_schema = validated_object_schema_for_value(ctx, realm, arguments[1], object_type);
+
+    typename JSONImporter<T>::Options options;
+    if (argc == 4 && !Value::is_undefined(ctx, arguments[3])) {
+        ObjectType options_object = Value::validated_to_object(ctx, arguments[3], "options");
+
+        static const String format_string = "format";
+        ValueType format_value = Object::get_property(ctx, options_object, format_string);
+        if (!Value::is_undefined(ctx, format_value)) {
+            std::string format = Value::validated_to_string(ctx, format_value, "format");
+            if (format != "array" && format != "ndjson") {
+                throw std::invalid_argument("format must be 'array' or 'ndjson'.");
+            }
+            options.ndjson = format == "ndjson";
+        }
+
+        static const String batch_size_string = "batchSize";
+        ValueType batch_size_value = Object::get_property(ctx, options_object, batch_size_string);
+        if (!Value::is_undefined(ctx, batch_size_value)) {
+            double batch_size = Value::validated_to_number(ctx, batch_size_value, "batchSize");
+            if (batch_size < 1) {
+                throw std::invalid_argument("batchSize must be at least 1.");
+            }
+            options.batch_size = batch_size;
+        }
+
+        static const String update_string = "update";
+        ValueType update_value = Object::get_property(ctx, options_object, update_string);
+        if (!Value::is_undefined(ctx, update_value)) {
+            options.update = Value::validated_to_boolean(ctx, update_value, "update");
+        }
+
+        static const String progress_string = "progress";
+        ValueType progress_value = Object::get_property(ctx, options_object, progress_string);
+        if (!Value::is_undefined(ctx, progress_value)) {
+            options.progress = Value::validated_to_function(ctx, progress_value, "progress");
+        }
+    }
+
+    JSONImporter<T> importer(ctx, realm, object_schema, options);
+    size_t count;
+    if (Value::is_string(ctx, arguments[2])) {
+        std::string path = Value::to_string(ctx, arguments[2]);
+        std::ifstream stream(path, std::ios::in | std::ios::binary);
+        if (!stream.is_open()) {
+            throw std::runtime_error("Unable to open '" + path + "' for importing.");
+        }
+        count = importer.import(stream);
+    }
+    else {
+        ValueType buffer = arguments[2];
+        std::string data = NativeAccessor::to_binary(ctx, buffer);
+        count = importer.import(data.data(), data.size());
+    }
+
+    return_value.set((double)count);
+}
+
 template<typename T>
 void RealmClass<T>::schema_version(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
     validate_argument_count(argc, 1, 2);
@@ -485,6 +1059,7 @@ void RealmClass<T>::clear_test_state(ContextType ctx, FunctionType, ObjectType t
     validate_argument_count(argc, 0);
 
     js::clear_test_state();
+    Schema<T>::clear_cache();
 }
 
 template<typename T>
@@ -526,6 +1101,11 @@ void RealmClass<T>::get_read_only(ContextType ctx, ObjectType object, ReturnValu
     return_value.set(get_internal<T, RealmClass<T>>(object)->get()->config().read_only());
 }
 
+template<typename T>
+void RealmClass<T>::get_in_memory(ContextType ctx, ObjectType object, ReturnValue &return_value) {
+    return_value.set(get_internal<T, RealmClass<T>>(object)->get()->config().in_memory);
+}
+
 #if REALM_ENABLE_SYNC
 template<typename T>
 void RealmClass<T>::get_sync_session(ContextType ctx, ObjectType object, ReturnValue &return_value) {
@@ -585,6 +1165,11 @@ void RealmClass<T>::create(ContextType ctx, FunctionType, ObjectType this_object
         update = Value::validated_to_boolean(ctx, arguments[2], "update");
     }
 
+    auto delegate = get_delegate<T>(realm.get());
+    if (update && delegate && delegate->in_savepoint()) {
+        delegate->will_update(ctx, realm, object_schema, object);
+    }
+
     auto realm_object = realm::Object::create<ValueType>(ctx, realm, object_schema, object, update);
     return_value.set(RealmObjectClass<T>::create_instance(ctx, std::move(realm_object)));
 }
@@ -599,12 +1184,16 @@ void RealmClass<T>::delete_one(ContextType ctx, FunctionType, ObjectType this_ob
     }
 
     ObjectType arg = Value::validated_to_object(ctx, arguments[0]);
+    auto delegate = get_delegate<T>(realm.get());
 
     if (Object::template is_instance<RealmObjectClass<T>>(ctx, arg)) {
         auto object = get_internal<T, RealmObjectClass<T>>(arg);
         if (!object->is_valid()) {
             throw std::runtime_error("Object is invalid. Either it has been previously deleted or the Realm it belongs to has been closed.");
         }
+        if (delegate && delegate->in_savepoint()) {
+            delegate->will_delete(object->row());
+        }
 
         realm::TableRef table = ObjectStore::table_for_object_type(realm->read_group(), object->get_object_schema().name);
         table->move_last_over(object->row().get_index());
@@ -619,16 +1208,25 @@ void RealmClass<T>::delete_one(ContextType ctx, FunctionType, ObjectType this_ob
             }
 
             auto realm_object = get_internal<T, RealmObjectClass<T>>(object);
+            if (delegate && delegate->in_savepoint()) {
+                delegate->will_delete(realm_object->row());
+            }
             realm::TableRef table = ObjectStore::table_for_object_type(realm->read_group(), realm_object->get_object_schema().name);
             table->move_last_over(realm_object->row().get_index());
         }
     }
     else if (Object::template is_instance<ResultsClass<T>>(ctx, arg)) {
         auto results = get_internal<T, ResultsClass<T>>(arg);
+        if (delegate && delegate->in_savepoint()) {
+            delegate->refuse_irreversible_change("Deleting the objects of a collection");
+        }
         results->clear();
     }
     else if (Object::template is_instance<ListClass<T>>(ctx, arg)) {
         auto list = get_internal<T, ListClass<T>>(arg);
+        if (delegate && delegate->in_savepoint()) {
+            delegate->refuse_irreversible_change("Deleting the objects of a collection");
+        }
         list->delete_all();
     }
     else {
@@ -646,11 +1244,72 @@ void RealmClass<T>::delete_all(ContextType ctx, FunctionType, ObjectType this_ob
         throw std::runtime_error("Can only delete objects within a transaction.");
     }
 
-    for (auto objectSchema : realm->schema()) {
+    auto delegate = get_delegate<T>(realm.get());
+    if (delegate && delegate->in_savepoint()) {
+        delegate->refuse_irreversible_change("Deleting all objects");
+    }
+
+    for (auto &objectSchema : realm->schema()) {
         ObjectStore::table_for_object_type(realm->read_group(), objectSchema.name)->clear();
     }
 }
 
+template<typename T>
+void RealmClass<T>::truncate(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
+    validate_argument_count(argc, 0, 1);
+
+    SharedRealm realm = *get_internal<T, RealmClass<T>>(this_object);
+    auto delegate = get_delegate<T>(realm.get());
+
+    // Only write() sends "reset" and compacts once the transaction has been committed.
+    if (!delegate || !delegate->m_in_write || !realm->is_in_transaction()) {
+        throw std::runtime_error("Can only truncate a Realm within a write() callback.");
+    }
+
+    std::vector<const ObjectSchema *> object_schemas;
+    bool all_types = true;
+    bool compact = false;
+    if (argc == 1 && !Value::is_undefined(ctx, arguments[0])) {
+        static const String types_string = "types";
+        static const String compact_string = "compact";
+        ObjectType options = Value::validated_to_object(ctx, arguments[0], "options");
+
+        ValueType types_value = Object::get_property(ctx, options, types_string);
+        if (!Value::is_undefined(ctx, types_value)) {
+            ObjectType types = Value::validated_to_array(ctx, types_value, "types");
+            all_types = false;
+            uint32_t count = Object::validated_get_length(ctx, types);
+            for (uint32_t i = 0; i < count; i++) {
+                std::string object_type;
+                object_schemas.push_back(&validated_object_schema_for_value(ctx, realm, Object::get_property(ctx, types, i), object_type));
+            }
+        }
+
+        ValueType compact_value = Object::get_property(ctx, options, compact_string);
+        if (!Value::is_undefined(ctx, compact_value)) {
+            compact = Value::validated_to_boolean(ctx, compact_value, "compact");
+        }
+    }
+    if (all_types) {
+        for (auto &object_schema : realm->schema()) {
+            object_schemas.push_back(&object_schema);
+        }
+    }
+
+    if (delegate->in_savepoint()) {
+        delegate->refuse_irreversible_change("Truncating the Realm");
+    }
+
+    // Clearing a table is a single instruction in the transaction log, however many rows it had.
+    Group &group = realm->read_group();
+    for (auto object_schema : object_schemas) {
+        ObjectStore::table_for_object_type(group, object_schema->name)->clear();
+    }
+
+    delegate->m_truncated = true;
+    delegate->m_compact_after_commit = delegate->m_compact_after_commit || compact;
+}
+
 template<typename T>
 void RealmClass<T>::write(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
     validate_argument_count(argc, 1);
@@ -660,57 +1319,309 @@ void RealmClass<T>::write(ContextType ctx, FunctionType, ObjectType this_object,
 
     realm->begin_transaction();
 
+    auto delegate = get_delegate<T>(realm.get());
+    delegate->m_in_write = true;
     try {
         Function<T>::call(ctx, callback, this_object, 0, nullptr);
     }
     catch (std::exception &e) {
         realm->cancel_transaction();
+        delegate->m_in_write = false;
+        delegate->m_truncated = false;
+        delegate->m_compact_after_commit = false;
         throw;
     }
 
+    // Cleared before committing so that a failed commit can not leave them set for the next write.
+    bool truncated = delegate->m_truncated;
+    bool compact = delegate->m_compact_after_commit;
+    delegate->m_in_write = false;
+    delegate->m_truncated = false;
+    delegate->m_compact_after_commit = false;
+
     realm->commit_transaction();
+    NotificationStats::did_commit(realm->config().path);
+
+    if (truncated) {
+        delegate->notify("reset");
+        // Compacting only succeeds if no other instance has the file open.
+        if (compact && !realm->is_closed()) {
+            realm->compact();
+        }
+    }
+}
+
+template<typename T>
+void RealmClass<T>::savepoint(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
+    validate_argument_count(argc, 1);
+
+    SharedRealm realm = *get_internal<T, RealmClass<T>>(this_object);
+    FunctionType callback = Value::validated_to_function(ctx, arguments[0]);
+
+    if (!realm->is_in_transaction()) {
+        throw std::runtime_error("Can only create a savepoint within a write transaction.");
+    }
+
+    // Realms in a migration have no delegate to keep the undo log.
+    auto delegate = get_delegate<T>(realm.get());
+    if (!delegate) {
+        throw std::runtime_error("Savepoints can not be created during a migration.");
+    }
+    delegate->begin_savepoint(realm->read_group());
+
+    try {
+        return_value.set(Function<T>::call(ctx, callback, this_object, 0, nullptr));
+    }
+    catch (std::exception &e) {
+        delegate->rollback_savepoint(realm->read_group());
+        throw;
+    }
+
+    delegate->release_savepoint();
 }
 
 template<typename T>
 void RealmClass<T>::add_listener(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
     validate_argument_count(argc, 2);
 
-    validated_notification_name(ctx, arguments[0]);
+    std::string name = validated_notification_name(ctx, arguments[0]);
     auto callback = Value::validated_to_function(ctx, arguments[1]);
 
     SharedRealm realm = *get_internal<T, RealmClass<T>>(this_object);
     if (realm->is_closed()) {
         throw ClosedRealmException();
     }
-    get_delegate<T>(realm.get())->add_notification(callback);
+    get_delegate<T>(realm.get())->add_notification(name, callback);
 }
 
 template<typename T>
 void RealmClass<T>::remove_listener(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
     validate_argument_count(argc, 2);
 
-    validated_notification_name(ctx, arguments[0]);
+    std::string name = validated_notification_name(ctx, arguments[0]);
     auto callback = Value::validated_to_function(ctx, arguments[1]);
 
     SharedRealm realm = *get_internal<T, RealmClass<T>>(this_object);
     if (realm->is_closed()) {
         throw ClosedRealmException();
     }
-    get_delegate<T>(realm.get())->remove_notification(callback);
+    get_delegate<T>(realm.get())->remove_notification(name, callback);
 }
 
 template<typename T>
 void RealmClass<T>::remove_all_listeners(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
     validate_argument_count(argc, 0, 1);
-    if (argc) {
-        validated_notification_name(ctx, arguments[0]);
-    }
 
     SharedRealm realm = *get_internal<T, RealmClass<T>>(this_object);
     if (realm->is_closed()) {
         throw ClosedRealmException();
     }
-    get_delegate<T>(realm.get())->remove_all_notifications();
+
+    if (argc) {
+        get_delegate<T>(realm.get())->remove_all_notifications(validated_notification_name(ctx, arguments[0]));
+    }
+    else {
+        get_delegate<T>(realm.get())->remove_all_notifications();
+    }
+}
+
+template<typename T>
+void RealmClass<T>::get_notification_stats(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
+    validate_argument_count(argc, 0);
+
+    SharedRealm realm = *get_internal<T, RealmClass<T>>(this_object);
+    auto delegate = get_delegate<T>(realm.get());
+    if (!delegate) {
+        throw std::runtime_error("Notification statistics are not available for this Realm.");
+    }
+
+    auto histogram_object = [=](const LatencyHistogram &histogram) {
+        ObjectType object = Object::create_empty(ctx);
+        Object::set_property(ctx, object, "count", Value::from_number(ctx, histogram.count()));
+        Object::set_property(ctx, object, "p50", Value::from_number(ctx, histogram.percentile(50)));
+        Object::set_property(ctx, object, "p99", Value::from_number(ctx, histogram.percentile(99)));
+        return object;
+    };
+
+    NotificationStats &stats = *delegate->m_stats;
+    ObjectType object = Object::create_empty(ctx);
+    Object::set_property(ctx, object, "commitToNotify", histogram_object(stats.commit_to_notify));
+    Object::set_property(ctx, object, "notify", histogram_object(stats.notify));
+    Object::set_property(ctx, object, "callback", histogram_object(stats.callback));
+    return_value.set(object);
+}
+
+template<typename T>
+void RealmClass<T>::export_to(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
+    validate_argument_count(argc, 4);
+
+    SharedRealm realm = *get_internal<T, RealmClass<T>>(this_object);
+    ValueType source = arguments[0];
+    std::unique_ptr<realm::Results> results;
+    if (Value::is_object(ctx, source) && Object::template is_instance<ResultsClass<T>>(ctx, Value::to_object(ctx, source))) {
+        results.reset(new realm::Results(*get_internal<T, ResultsClass<T>>(Value::to_object(ctx, source))));
+        if (results->get_realm() != realm) {
+            throw std::invalid_argument("Only Results of this Realm can be exported.");
+        }
+    }
+    else {
+        std::string object_type;
+        validated_object_schema_for_value(ctx, realm, source, object_type);
+        results.reset(new realm::Results(realm, *ObjectStore::table_for_object_type(realm->read_group(), object_type)));
+    }
+
+    std::string path = Value::validated_to_string(ctx, arguments[1], "path");
+
+    ResultsExporter::Options options;
+    bool background = false;
+    if (!Value::is_undefined(ctx, arguments[2])) {
+        ObjectType options_object = Value::validated_to_object(ctx, arguments[2], "options");
+
+        static const String format_string = "format";
+        ValueType format_value = Object::get_property(ctx, options_object, format_string);
+        if (!Value::is_undefined(ctx, format_value)) {
+            std::string format = Value::validated_to_string(ctx, format_value, "format");
+            if (format != "ndjson" && format != "csv") {
+                throw std::invalid_argument("format must be 'ndjson' or 'csv'.");
+            }
+            options.format = format == "csv" ? ResultsExporter::Format::CSV : ResultsExporter::Format::NDJSON;
+        }
+
+        static const String projection_string = "projection";
+        ValueType projection_value = Object::get_property(ctx, options_object, projection_string);
+        if (!Value::is_undefined(ctx, projection_value)) {
+            ObjectType projection_object = Value::validated_to_array(ctx, projection_value, "projection");
+            uint32_t length = Object::validated_get_length(ctx, projection_object);
+            for (uint32_t i = 0; i < length; i++) {
+                options.projection.push_back(Object::validated_get_string(ctx, projection_object, i, "projection"));
+            }
+        }
+
+        static const String link_depth_string = "linkDepth";
+        ValueType link_depth_value = Object::get_property(ctx, options_object, link_depth_string);
+        if (!Value::is_undefined(ctx, link_depth_value)) {
+            double link_depth = Value::validated_to_number(ctx, link_depth_value, "linkDepth");
+            if (link_depth < 0) {
+                throw std::invalid_argument("linkDepth must not be negative.");
+            }
+            options.link_depth = link_depth;
+        }
+
+        static const String background_string = "background";
+        ValueType background_value = Object::get_property(ctx, options_object, background_string);
+        if (!Value::is_undefined(ctx, background_value)) {
+            background = Value::validated_to_boolean(ctx, background_value, "background");
+        }
+    }
+
+    FunctionType callback = Value::validated_to_function(ctx, arguments[3], "callback");
+
+    if (!background) {
+        ResultsExporter exporter(std::move(*results), std::move(options));
+        auto stats = exporter.write_to(path);
+
+        ValueType callback_arguments[2] = {Value::from_undefined(ctx), create_stats_object(ctx, export_stats(stats))};
+        Function::call(ctx, callback, 2, callback_arguments);
+        return;
+    }
+
+    if (realm->is_in_transaction()) {
+        throw std::runtime_error("Can not export on a background thread within a write transaction.");
+    }
+    // Fails early on an invalid projection.
+    ResultsExporter validated_exporter(*results, options);
+
+    // The Results are resolved at the version they were handed over at.
+    auto reference = std::make_shared<ThreadSafeReference<realm::Results>>(realm->obtain_thread_safe_reference(*results));
+    run_in_background(ctx, realm, callback, [=](SharedRealm background_realm) {
+        ResultsExporter exporter(background_realm->resolve_thread_safe_reference(std::move(*reference)), options);
+        return export_stats(exporter.write_to(path));
+    });
+}
+
+template<typename T>
+void RealmClass<T>::write_copy_to(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
+    validate_argument_count(argc, 3);
+
+    SharedRealm realm = *get_internal<T, RealmClass<T>>(this_object);
+    if (realm->is_in_transaction()) {
+        throw std::runtime_error("Can not write a copy of a Realm within a write transaction.");
+    }
+
+    std::string path = normalize_realm_path(Value::validated_to_string(ctx, arguments[0], "path"));
+    ensure_directory_exists_for_file(path);
+
+    std::vector<char> encryption_key;
+    bool background = false;
+    if (!Value::is_undefined(ctx, arguments[1])) {
+        ObjectType options_object = Value::validated_to_object(ctx, arguments[1], "options");
+
+        static const String encryption_key_string = "encryptionKey";
+        ValueType encryption_key_value = Object::get_property(ctx, options_object, encryption_key_string);
+        if (!Value::is_undefined(ctx, encryption_key_value)) {
+            std::string key = NativeAccessor::to_binary(ctx, encryption_key_value);
+            if (key.size() != 64) {
+                throw std::invalid_argument("encryptionKey must be 64 bytes long.");
+            }
+            encryption_key.assign(key.begin(), key.end());
+        }
+
+        static const String compact_string = "compact";
+        ValueType compact_value = Object::get_property(ctx, options_object, compact_string);
+        if (!Value::is_undefined(ctx, compact_value) && !Value::validated_to_boolean(ctx, compact_value, "compact")) {
+            throw std::invalid_argument("Copies of a Realm are always compacted.");
+        }
+
+        static const String background_string = "background";
+        ValueType background_value = Object::get_property(ctx, options_object, background_string);
+        if (!Value::is_undefined(ctx, background_value)) {
+            background = Value::validated_to_boolean(ctx, background_value, "background");
+        }
+    }
+
+    FunctionType callback = Value::validated_to_function(ctx, arguments[2], "callback");
+
+    if (!background) {
+        ValueType callback_arguments[2] = {Value::from_undefined(ctx), create_stats_object(ctx, write_copy(*realm, path, encryption_key))};
+        Function::call(ctx, callback, 2, callback_arguments);
+        return;
+    }
+
+    // The background instance reads the latest version, without blocking writers.
+    run_in_background(ctx, realm, callback, [=](SharedRealm background_realm) {
+        return write_copy(*background_realm, path, encryption_key);
+    });
+}
+
+template<typename T>
+void RealmClass<T>::compact(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
+    validate_argument_count(argc, 0);
+
+    SharedRealm realm = *get_internal<T, RealmClass<T>>(this_object);
+    if (realm->is_in_transaction()) {
+        throw std::runtime_error("Can not compact a Realm within a write transaction.");
+    }
+    return_value.set(realm->compact());
+}
+
+template<typename T>
+void RealmClass<T>::get_file_stats(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
+    validate_argument_count(argc, 0);
+
+    SharedRealm realm = *get_internal<T, RealmClass<T>>(this_object);
+    RealmFileSession::Stats stats;
+    try {
+        stats = RealmFileSession(realm->config()).stats();
+    }
+    catch (FileFormatUpgradeRequired const&) {
+        throw std::runtime_error("File stats are not available for Realms opened read-only from files of an older file format.");
+    }
+
+    ObjectType object = Object::create_empty(ctx);
+    Object::set_property(ctx, object, "totalBytes", Value::from_number(ctx, stats.total_bytes));
+    Object::set_property(ctx, object, "usedBytes", Value::from_number(ctx, stats.used_bytes));
+    Object::set_property(ctx, object, "freeBytes", Value::from_number(ctx, stats.total_bytes - stats.used_bytes));
+    return_value.set(object);
 }
 
 template<typename T>
@@ -718,6 +1629,9 @@ void RealmClass<T>::close(ContextType ctx, FunctionType, ObjectType this_object,
     validate_argument_count(argc, 0);
 
     SharedRealm realm = *get_internal<T, RealmClass<T>>(this_object);
+    if (auto delegate = get_delegate<T>(realm.get())) {
+        delegate->m_async_evaluations.clear();
+    }
     realm->close();
 }
 
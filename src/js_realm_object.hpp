@@ -19,9 +19,12 @@
 #pragma once
 
 #include "js_class.hpp"
+#include "js_observable.hpp"
 #include "js_types.hpp"
 #include "js_util.hpp"
+#include "notification_stats.hpp"
 
+#include "collection_notifications.hpp"
 #include "object_accessor.hpp"
 #include "object_store.hpp"
 
@@ -29,7 +32,16 @@ namespace realm {
 namespace js {
 
 template<typename T>
-struct RealmObjectClass : ClassDefinition<T, realm::Object> {
+class RealmObject : public realm::Object {
+  public:
+    RealmObject(realm::Object const& o) : realm::Object(o) {}
+    RealmObject(realm::Object&& o) : realm::Object(std::move(o)) {}
+
+    ListenerRegistry<T> m_notification_tokens;
+};
+
+template<typename T>
+struct RealmObjectClass : ClassDefinition<T, realm::js::RealmObject<T>> {
     using ContextType = typename T::Context;
     using FunctionType = typename T::Function;
     using ObjectType = typename T::Object;
@@ -48,6 +60,13 @@ struct RealmObjectClass : ClassDefinition<T, realm::Object> {
     
     static void is_valid(ContextType, FunctionType, ObjectType, size_t, const ValueType [], ReturnValue &);
 
+    // observable
+    static void add_listener(ContextType, FunctionType, ObjectType, size_t, const ValueType [], ReturnValue &);
+    static void remove_listener(ContextType, FunctionType, ObjectType, size_t, const ValueType [], ReturnValue &);
+    static void remove_all_listeners(ContextType, FunctionType, ObjectType, size_t, const ValueType [], ReturnValue &);
+
+    static ValueType create_object_change_set(ContextType, const realm::Object &, const CollectionChangeSet &);
+
     const std::string name = "RealmObject";
 
     const StringPropertyType<T> string_accessor = {
@@ -58,6 +77,9 @@ struct RealmObjectClass : ClassDefinition<T, realm::Object> {
 
     MethodMap<T> const methods = {
         {"isValid", wrap<is_valid>},
+        {"addListener", wrap<add_listener>},
+        {"removeListener", wrap<remove_listener>},
+        {"removeAllListeners", wrap<remove_all_listeners>},
     };
 };
 
@@ -66,13 +88,90 @@ void RealmObjectClass<T>::is_valid(ContextType ctx, FunctionType, ObjectType thi
     return_value.set(get_internal<T, RealmObjectClass<T>>(this_object)->is_valid());
 }
     
+template<typename T>
+typename T::Value RealmObjectClass<T>::create_object_change_set(ContextType ctx, const realm::Object &realm_object, const CollectionChangeSet &change_set) {
+    ObjectType object = Object::create_empty(ctx);
+    bool deleted = !change_set.deletions.empty();
+    Object::set_property(ctx, object, "deleted", Value::from_boolean(ctx, deleted));
+
+    std::vector<ValueType> changed_properties;
+    if (!deleted) {
+        for (auto &property : realm_object.get_object_schema().persisted_properties) {
+            if (property.table_column < change_set.columns.size() && !change_set.columns[property.table_column].empty()) {
+                changed_properties.push_back(Value::from_string(ctx, property.name));
+            }
+        }
+    }
+    Object::set_property(ctx, object, "changedProperties", Object::create_array(ctx, changed_properties));
+
+    return object;
+}
+
+template<typename T>
+void RealmObjectClass<T>::add_listener(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
+    validate_argument_count(argc, 1);
+
+    auto realm_object = get_internal<T, RealmObjectClass<T>>(this_object);
+    if (!realm_object->is_valid()) {
+        throw std::runtime_error("Object is invalid. Either it has been previously deleted or the Realm it belongs to has been closed.");
+    }
+
+    auto callback = Value::validated_to_function(ctx, arguments[0]);
+    Protected<FunctionType> protected_callback(ctx, callback);
+    Protected<ObjectType> protected_this(ctx, this_object);
+    Protected<typename T::GlobalContext> protected_ctx(Context<T>::get_global_context(ctx));
+    // Realms in a migration have no delegate, so the timings of their listeners are not reported.
+    auto delegate = get_delegate<T>(realm_object->realm().get());
+    std::shared_ptr<NotificationStats> stats = delegate ? delegate->m_stats : std::make_shared<NotificationStats>(realm_object->realm()->config().path);
+
+    // The object notifier tracks just this row, so no query has to be re-run to observe it.
+    auto token = realm_object->add_notification_callback([=](CollectionChangeSet change_set, std::exception_ptr exception) {
+        // The initial delivery carries no changes.
+        if (change_set.empty()) {
+            return;
+        }
+
+        HANDLESCOPE
+
+        ObjectType object = protected_this;
+        ValueType arguments[2];
+        arguments[0] = object;
+        arguments[1] = create_object_change_set(protected_ctx, *get_internal<T, RealmObjectClass<T>>(object), change_set);
+        NotificationStats::CallbackTimer timer(*stats);
+        Function::call(protected_ctx, protected_callback, object, 2, arguments);
+    });
+    return_value.set((double)realm_object->m_notification_tokens.add(protected_callback, std::move(token)));
+}
+
+template<typename T>
+void RealmObjectClass<T>::remove_listener(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
+    validate_argument_count(argc, 1);
+
+    auto realm_object = get_internal<T, RealmObjectClass<T>>(this_object);
+    if (Value::is_number(ctx, arguments[0])) {
+        realm_object->m_notification_tokens.remove((typename ListenerRegistry<T>::Id)Value::to_number(ctx, arguments[0]));
+        return;
+    }
+
+    auto callback = Value::validated_to_function(ctx, arguments[0]);
+    realm_object->m_notification_tokens.remove(Protected<FunctionType>(ctx, callback));
+}
+
+template<typename T>
+void RealmObjectClass<T>::remove_all_listeners(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
+    validate_argument_count(argc, 0);
+
+    auto realm_object = get_internal<T, RealmObjectClass<T>>(this_object);
+    realm_object->m_notification_tokens.clear();
+}
+
 template<typename T>
 typename T::Object RealmObjectClass<T>::create_instance(ContextType ctx, realm::Object realm_object) {
     static String prototype_string = "prototype";
 
     auto delegate = get_delegate<T>(realm_object.realm().get());
     auto name = realm_object.get_object_schema().name;
-    auto object = create_object<T, RealmObjectClass<T>>(ctx, new realm::Object(std::move(realm_object)));
+    auto object = create_object<T, RealmObjectClass<T>>(ctx, new realm::js::RealmObject<T>(std::move(realm_object)));
 
     if (!delegate || !delegate->m_constructors.count(name)) {
         return object;
@@ -106,10 +205,16 @@ bool RealmObjectClass<T>::set_property(ContextType ctx, ObjectType object, const
     auto realm_object = get_internal<T, RealmObjectClass<T>>(object);
 
     std::string property_name = property;
-    if (!realm_object->get_object_schema().property_for_name(property_name)) {
+    const Property *prop = realm_object->get_object_schema().property_for_name(property_name);
+    if (!prop) {
         return false;
     }
 
+    auto delegate = get_delegate<T>(realm_object->realm().get());
+    if (delegate && delegate->in_savepoint()) {
+        delegate->will_set_property(ctx, *realm_object, *prop);
+    }
+
     try {
         realm_object->set_property_value(ctx, property_name, value, true);
     }
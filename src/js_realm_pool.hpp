@@ -0,0 +1,260 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2016 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "datetime_upgrade.hpp"
+#include "js_class.hpp"
+#include "js_schema.hpp"
+#include "js_types.hpp"
+#include "js_util.hpp"
+
+#include "platform.hpp"
+#include "shared_realm.hpp"
+
+namespace realm {
+namespace js {
+
+template<typename T>
+class RealmClass;
+
+// Realms kept open by a Realm.Pool. Every one of them is a separate instance of the Realm which
+// is not cached by the object store, so an acquired Realm stays at its version until released.
+template<typename T>
+struct RealmPool {
+    using ObjectType = typename T::Object;
+
+    struct Entry {
+        Protected<ObjectType> object;
+        SharedRealm realm;
+    };
+
+    realm::Realm::Config config;
+    typename Schema<T>::ObjectDefaultsMap defaults;
+    typename Schema<T>::ConstructorMap constructors;
+    bool schema_updated = false;
+    util::Optional<double> group_commit_ms, group_commit_max;
+    size_t max = 0;
+    bool closed = false;
+
+    std::vector<Entry> idle;
+    std::vector<Entry> acquired;
+
+    size_t hits = 0;
+    size_t misses = 0;
+    double open_seconds = 0;
+};
+
+template<typename T>
+class RealmPoolClass : public ClassDefinition<T, RealmPool<T>> {
+    using ContextType = typename T::Context;
+    using FunctionType = typename T::Function;
+    using ObjectType = typename T::Object;
+    using ValueType = typename T::Value;
+    using String = js::String<T>;
+    using Object = js::Object<T>;
+    using Value = js::Value<T>;
+    using ReturnValue = js::ReturnValue<T>;
+
+  public:
+    std::string const name = "Pool";
+
+    static const size_t default_max = 16;
+
+    static void constructor(ContextType, ObjectType, size_t, const ValueType[]);
+
+    static void acquire(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
+    static void release(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
+    static void close(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
+
+    static void get_metrics(ContextType, ObjectType, ReturnValue &);
+
+    MethodMap<T> const methods = {
+        {"acquire", wrap<acquire>},
+        {"release", wrap<release>},
+        {"close", wrap<close>},
+    };
+
+    PropertyMap<T> const properties = {
+        {"metrics", {wrap<get_metrics>, nullptr}},
+    };
+
+  private:
+    static typename RealmPool<T>::Entry open_realm(ContextType ctx, RealmPool<T> &pool) {
+        auto start = std::chrono::steady_clock::now();
+
+        auto defaults = pool.defaults;
+        auto constructors = pool.constructors;
+        SharedRealm realm = RealmClass<T>::create_shared_realm(ctx, pool.config, pool.schema_updated, std::move(defaults), std::move(constructors));
+        DatetimeUpgrade(realm).run();
+
+        // Pooled Realms only move to a newer version when acquired.
+        realm->set_auto_refresh(false);
+
+        ObjectType object = create_object<T, RealmClass<T>>(ctx, new SharedRealm(realm));
+        RealmClass<T>::set_group_commit_properties(ctx, object, pool.group_commit_ms, pool.group_commit_max);
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        pool.open_seconds += elapsed.count();
+        pool.misses++;
+
+        return {Protected<ObjectType>(ctx, object), realm};
+    }
+};
+
+template<typename T>
+void RealmPoolClass<T>::constructor(ContextType ctx, ObjectType this_object, size_t argc, const ValueType arguments[]) {
+    static const String config_string = "config";
+    static const String max_string = "max";
+
+    validate_argument_count(argc, 1);
+    ObjectType options = Value::validated_to_object(ctx, arguments[0], "options");
+
+    ValueType config_value = Object::get_property(ctx, options, config_string);
+    auto parsed = RealmClass<T>::parse_config(ctx, Value::is_undefined(ctx, config_value) ? 0 : 1, &config_value);
+    if (parsed.should_compact_on_launch || parsed.upgrade_progress) {
+        throw std::invalid_argument("shouldCompactOnLaunch and upgradeProgress are not supported by Realm.Pool, use Realm.open() to prepare the file first.");
+    }
+
+    size_t max = default_max;
+    ValueType max_value = Object::get_property(ctx, options, max_string);
+    if (!Value::is_undefined(ctx, max_value)) {
+        double max_number = Value::validated_to_number(ctx, max_value, "max");
+        if (max_number < 0) {
+            throw std::invalid_argument("max must not be negative.");
+        }
+        max = (size_t)max_number;
+    }
+
+    ensure_directory_exists_for_file(parsed.config.path);
+
+    auto pool = new RealmPool<T>();
+    pool->config = std::move(parsed.config);
+    pool->config.cache = false;
+    pool->defaults = std::move(parsed.defaults);
+    pool->constructors = std::move(parsed.constructors);
+    pool->schema_updated = parsed.schema_updated;
+    pool->group_commit_ms = parsed.group_commit_ms;
+    pool->group_commit_max = parsed.group_commit_max;
+    pool->max = max;
+
+    set_internal<T, RealmPoolClass<T>>(this_object, pool);
+
+    // The first Realm validates the schema and upgrades the file, so this happens right away.
+    if (pool->max > 0) {
+        pool->idle.push_back(open_realm(ctx, *pool));
+    }
+}
+
+template<typename T>
+void RealmPoolClass<T>::acquire(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
+    validate_argument_count(argc, 0);
+
+    RealmPool<T> &pool = *get_internal<T, RealmPoolClass<T>>(this_object);
+    if (pool.closed) {
+        throw std::runtime_error("The pool has been closed.");
+    }
+
+    while (!pool.idle.empty()) {
+        auto entry = std::move(pool.idle.back());
+        pool.idle.pop_back();
+        if (entry.realm->is_closed()) {
+            continue;
+        }
+
+        entry.realm->refresh();
+        pool.hits++;
+        pool.acquired.push_back(entry);
+        return_value.set(static_cast<ObjectType>(entry.object));
+        return;
+    }
+
+    auto entry = open_realm(ctx, pool);
+    pool.acquired.push_back(entry);
+    return_value.set(static_cast<ObjectType>(entry.object));
+}
+
+template<typename T>
+void RealmPoolClass<T>::release(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
+    validate_argument_count(argc, 1);
+
+    RealmPool<T> &pool = *get_internal<T, RealmPoolClass<T>>(this_object);
+    ObjectType realm_object = Value::validated_to_object(ctx, arguments[0], "realm");
+    if (!Object::template is_instance<RealmClass<T>>(ctx, realm_object)) {
+        throw std::invalid_argument("Object must be a Realm.");
+    }
+
+    SharedRealm realm = *get_internal<T, RealmClass<T>>(realm_object);
+    auto entry = std::find_if(pool.acquired.begin(), pool.acquired.end(), [&](const typename RealmPool<T>::Entry &entry) {
+        return entry.realm == realm;
+    });
+    if (entry == pool.acquired.end()) {
+        throw std::invalid_argument("The Realm was not acquired from this pool.");
+    }
+    if (!realm->is_closed() && realm->is_in_transaction()) {
+        throw std::runtime_error("Can not release a Realm in a write transaction.");
+    }
+
+    auto released = std::move(*entry);
+    pool.acquired.erase(entry);
+    if (realm->is_closed()) {
+        return;
+    }
+
+    if (pool.closed || pool.idle.size() >= pool.max) {
+        realm->close();
+        return;
+    }
+
+    // Ending the read transaction lets the file drop the version the Realm was at.
+    realm->invalidate();
+    pool.idle.push_back(std::move(released));
+}
+
+template<typename T>
+void RealmPoolClass<T>::close(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
+    validate_argument_count(argc, 0);
+
+    RealmPool<T> &pool = *get_internal<T, RealmPoolClass<T>>(this_object);
+    for (auto &entry : pool.idle) {
+        entry.realm->close();
+    }
+    pool.idle.clear();
+    pool.closed = true;
+}
+
+template<typename T>
+void RealmPoolClass<T>::get_metrics(ContextType ctx, ObjectType object, ReturnValue &return_value) {
+    RealmPool<T> &pool = *get_internal<T, RealmPoolClass<T>>(object);
+
+    ObjectType metrics = Object::create_empty(ctx);
+    Object::set_property(ctx, metrics, "hits", Value::from_number(ctx, pool.hits));
+    Object::set_property(ctx, metrics, "misses", Value::from_number(ctx, pool.misses));
+    Object::set_property(ctx, metrics, "openSeconds", Value::from_number(ctx, pool.open_seconds));
+    Object::set_property(ctx, metrics, "averageOpenSeconds", Value::from_number(ctx, pool.misses ? pool.open_seconds / pool.misses : 0));
+    Object::set_property(ctx, metrics, "idle", Value::from_number(ctx, pool.idle.size()));
+    Object::set_property(ctx, metrics, "acquired", Value::from_number(ctx, pool.acquired.size()));
+    return_value.set(metrics);
+}
+
+} // js
+} // realm
@@ -41,7 +41,7 @@ class Results : public realm::Results {
 
     using realm::Results::Results;
 
-    std::vector<std::pair<Protected<typename T::Function>, NotificationToken>> m_notification_tokens;
+    ListenerRegistry<T> m_notification_tokens;
 };
 
 template<typename T>
@@ -70,6 +70,8 @@ struct ResultsClass : ClassDefinition<T, realm::js::Results<T>, CollectionClass<
     static void filtered(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
     static void sorted(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
     static void is_valid(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
+    static void evaluate_async(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
+    static void get_batch(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
 
     // observable
     static void add_listener(ContextType, FunctionType, ObjectType, size_t, const ValueType[], ReturnValue &);
@@ -83,6 +85,8 @@ struct ResultsClass : ClassDefinition<T, realm::js::Results<T>, CollectionClass<
         {"filtered", wrap<filtered>},
         {"sorted", wrap<sorted>},
         {"isValid", wrap<is_valid>},
+        {"_evaluateAsync", wrap<evaluate_async>},
+        {"_getBatch", wrap<get_batch>},
         {"addListener", wrap<add_listener>},
         {"removeListener", wrap<remove_listener>},
         {"removeAllListeners", wrap<remove_all_listeners>},
@@ -93,6 +97,10 @@ struct ResultsClass : ClassDefinition<T, realm::js::Results<T>, CollectionClass<
     };
     
     IndexPropertyType<T> const index_accessor = {wrap<get_index>, nullptr};
+
+  private:
+    static ValueType get_plain_value(ContextType, realm::Object &, const Property &);
+    static ValueType get_linked_primary_key(ContextType, SharedRealm, const std::string &, RowExpr);
 };
 
 template<typename T>
@@ -237,24 +245,177 @@ void ResultsClass<T>::is_valid(ContextType ctx, FunctionType, ObjectType this_ob
 }
     
 template<typename T>
-void ResultsClass<T>::add_listener(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
+void ResultsClass<T>::evaluate_async(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
     validate_argument_count(argc, 1);
+
+    auto results = get_internal<T, ResultsClass<T>>(this_object);
+    auto callback = Value::validated_to_function(ctx, arguments[0]);
+    Protected<FunctionType> protected_callback(ctx, callback);
+    Protected<ObjectType> protected_this(ctx, this_object);
+    Protected<typename T::GlobalContext> protected_ctx(Context<T>::get_global_context(ctx));
+
+    auto delegate = get_delegate<T>(results->get_realm().get());
+    if (!delegate) {
+        throw std::runtime_error("Results can not be evaluated asynchronously during a migration.");
+    }
+
+    // The query is run by the results notifier on the background thread and the first delivery
+    // hands its TableView over to this thread, so only that import happens on the JS thread.
+    auto token = std::make_shared<NotificationToken>();
+    delegate->m_async_evaluations.push_back(token);
+    std::weak_ptr<NotificationToken> weak_token = token;
+    std::weak_ptr<realm::Realm> weak_realm = results->get_realm();
+    *token = results->add_notification_callback([=](CollectionChangeSet, std::exception_ptr exception) {
+        auto token = weak_token.lock();
+        if (!token) {
+            return;
+        }
+
+        HANDLESCOPE
+
+        // Unregister before calling back so the query is not re-run in the background after every commit.
+        NotificationToken finished_token = std::move(*token);
+        if (auto realm = weak_realm.lock()) {
+            if (auto delegate = get_delegate<T>(realm.get())) {
+                delegate->m_async_evaluations.remove(token);
+            }
+        }
+
+        ValueType arguments[2];
+        arguments[0] = Value::from_undefined(protected_ctx);
+        arguments[1] = static_cast<ObjectType>(protected_this);
+        if (exception) {
+            try {
+                std::rethrow_exception(exception);
+            }
+            catch (std::exception &e) {
+                arguments[0] = Value::from_string(protected_ctx, e.what());
+                arguments[1] = Value::from_undefined(protected_ctx);
+            }
+        }
+        Function<T>::call(protected_ctx, protected_callback, protected_this, 2, arguments);
+    });
+}
+
+template<typename T>
+void ResultsClass<T>::get_batch(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
+    validate_argument_count(argc, 2, 3);
+
+    auto results = get_internal<T, ResultsClass<T>>(this_object);
+    auto const &object_schema = results->get_object_schema();
+    size_t start = Value::validated_to_number(ctx, arguments[0], "start");
+    size_t count = Value::validated_to_number(ctx, arguments[1], "count");
+
+    std::vector<const Property *> properties;
+    if (argc == 3 && !Value::is_undefined(ctx, arguments[2])) {
+        ObjectType projection = Value::validated_to_array(ctx, arguments[2], "projection");
+        uint32_t length = Object::validated_get_length(ctx, projection);
+        for (uint32_t i = 0; i < length; i++) {
+            std::string property_name = Object::validated_get_string(ctx, projection, i);
+            const Property *property = object_schema.property_for_name(property_name);
+            if (!property) {
+                throw std::runtime_error("Property '" + property_name + "' does not exist on object type '" + object_schema.name + "'");
+            }
+            properties.push_back(property);
+        }
+    }
+    else {
+        for (auto &property : object_schema.persisted_properties) {
+            properties.push_back(&property);
+        }
+    }
+
+    size_t end = std::min(results->size(), start + count);
+    std::vector<ValueType> rows;
+    rows.reserve(end > start ? end - start : 0);
+
+    for (size_t index = start; index < end; index++) {
+        auto row = results->get(index);
+
+        // Skip objects deleted since a snapshot was taken.
+        if (!row.is_attached()) {
+            continue;
+        }
+
+        realm::Object realm_object(results->get_realm(), object_schema, row);
+        ObjectType object = Object::create_empty(ctx);
+        for (auto property : properties) {
+            Object::set_property(ctx, object, property->name, get_plain_value(ctx, realm_object, *property));
+        }
+        rows.push_back(object);
+    }
+
+    return_value.set(Object::create_array(ctx, rows));
+}
+
+// Links are given as the primary key of the linked object, like in Realm.exportTo(), so that
+// batches only contain plain values.
+template<typename T>
+typename T::Value ResultsClass<T>::get_plain_value(ContextType ctx, realm::Object &realm_object, const Property &property) {
+    auto row = realm_object.row();
+    size_t column = property.table_column;
+
+    switch (property.type) {
+        case PropertyType::Object: {
+            if (row.is_null_link(column)) {
+                return Value::from_null(ctx);
+            }
+            auto target = row.get_table()->get_link_target(column);
+            return get_linked_primary_key(ctx, realm_object.realm(), property.object_type, target->get(row.get_link(column)));
+        }
+        case PropertyType::Array: {
+            LinkViewRef link_view = row.get_linklist(column);
+            std::vector<ValueType> keys;
+            keys.reserve(link_view->size());
+            for (size_t i = 0; i < link_view->size(); ++i) {
+                keys.push_back(get_linked_primary_key(ctx, realm_object.realm(), property.object_type, link_view->get(i)));
+            }
+            return Object::create_array(ctx, keys);
+        }
+        default:
+            return realm_object.template get_property_value<ValueType>(ctx, property.name);
+    }
+}
+
+template<typename T>
+typename T::Value ResultsClass<T>::get_linked_primary_key(ContextType ctx, SharedRealm realm, const std::string &object_type, RowExpr row) {
+    auto &object_schema = *realm->schema().find(object_type);
+    const Property *primary_key = object_schema.primary_key_property();
+    if (!primary_key) {
+        return Value::from_null(ctx);
+    }
+
+    realm::Object linked_object(realm, object_schema, row);
+    return linked_object.template get_property_value<ValueType>(ctx, primary_key->name);
+}
+
+template<typename T>
+void ResultsClass<T>::add_listener(ContextType ctx, FunctionType, ObjectType this_object, size_t argc, const ValueType arguments[], ReturnValue &return_value) {
+    validate_argument_count(argc, 1, 2);
     
     auto results = get_internal<T, ResultsClass<T>>(this_object);
     auto callback = Value::validated_to_function(ctx, arguments[0]);
     Protected<FunctionType> protected_callback(ctx, callback);
     Protected<ObjectType> protected_this(ctx, this_object);
     Protected<typename T::GlobalContext> protected_ctx(Context<T>::get_global_context(ctx));
+    // Realms in a migration have no delegate, so the timings of their listeners are not reported.
+    auto delegate = get_delegate<T>(results->get_realm().get());
+    std::shared_ptr<NotificationStats> stats = delegate ? delegate->m_stats : std::make_shared<NotificationStats>(results->get_realm()->config().path);
+    CollectionListenerOptions options;
+    if (argc == 2 && !Value::is_undefined(ctx, arguments[1])) {
+        options = CollectionClass<T>::parse_listener_options(ctx, arguments[1]);
+    }
     
-    auto token = results->add_notification_callback([=](CollectionChangeSet change_set, std::exception_ptr exception) {
+    auto token = results->add_notification_callback(make_listener_callback(options, [=](CollectionChangeSet change_set) {
         HANDLESCOPE
 
         ValueType arguments[2];
         arguments[0] = static_cast<ObjectType>(protected_this);
-        arguments[1] = CollectionClass<T>::create_collection_change_set(protected_ctx, change_set);
+        arguments[1] = CollectionClass<T>::create_collection_change_set(protected_ctx, change_set, options);
+        NotificationStats::CallbackTimer timer(*stats);
         Function<T>::call(protected_ctx, protected_callback, protected_this, 2, arguments);
-    });
-    results->m_notification_tokens.emplace_back(protected_callback, std::move(token));
+    }));
+    return_value.set((double)results->m_notification_tokens.add(protected_callback, std::move(token)));
 }
 
 template<typename T>
@@ -262,19 +423,13 @@ void ResultsClass<T>::remove_listener(ContextType ctx, FunctionType, ObjectType
     validate_argument_count(argc, 1);
     
     auto results = get_internal<T, ResultsClass<T>>(this_object);
-    auto callback = Value::validated_to_function(ctx, arguments[0]);
-    auto protected_function = Protected<FunctionType>(ctx, callback);
-    
-    auto iter = results->m_notification_tokens.begin();
-    typename Protected<FunctionType>::Comparator compare;
-    while (iter != results->m_notification_tokens.end()) {
-        if(compare(iter->first, protected_function)) {
-            iter = results->m_notification_tokens.erase(iter);
-        }
-        else {
-            iter++;
-        }
+    if (Value::is_number(ctx, arguments[0])) {
+        results->m_notification_tokens.remove((typename ListenerRegistry<T>::Id)Value::to_number(ctx, arguments[0]));
+        return;
     }
+
+    auto callback = Value::validated_to_function(ctx, arguments[0]);
+    results->m_notification_tokens.remove(Protected<FunctionType>(ctx, callback));
 }
 
 template<typename T>
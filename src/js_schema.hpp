@@ -19,6 +19,8 @@
 #pragma once
 
 #include <map>
+#include <memory>
+#include <unordered_map>
 
 #include "js_types.hpp"
 #include "schema.hpp"
@@ -40,14 +42,38 @@ struct Schema {
     using ObjectDefaultsMap = std::map<std::string, ObjectDefaults>;
     using ConstructorMap = std::map<std::string, Protected<FunctionType>>;
 
+    struct ParsedSchema {
+        realm::Schema schema;
+        ObjectDefaultsMap defaults;
+        ConstructorMap constructors;
+    };
+
     static ObjectType dict_for_property_array(ContextType, const ObjectSchema &, ObjectType);
     static Property parse_property(ContextType, ValueType, std::string, ObjectDefaults &);
+    static void parse_compound_indexes(ContextType, ObjectType, ObjectSchema &);
     static ObjectSchema parse_object_schema(ContextType, ObjectType, ObjectDefaultsMap &, ConstructorMap &);
     static realm::Schema parse_schema(ContextType, ObjectType, ObjectDefaultsMap &, ConstructorMap &);
+    static std::shared_ptr<const ParsedSchema> parse_cached_schema(ContextType, ObjectType);
+    static void clear_cache();
 
     static ObjectType object_for_schema(ContextType, const realm::Schema &);
     static ObjectType object_for_object_schema(ContextType, const ObjectSchema &);
     static ObjectType object_for_property(ContextType, const Property &);
+
+  private:
+    // Schemas are cached by the identity of their array, which can only be relied on while
+    // nothing in it can change.
+    using Cache = std::unordered_map<Protected<ObjectType>, std::shared_ptr<const ParsedSchema>,
+                                     typename Protected<ObjectType>::Hasher, typename Protected<ObjectType>::Comparator>;
+    static const size_t max_cache_size = 64;
+
+    static Cache &cache() {
+        static Cache s_cache;
+        return s_cache;
+    }
+
+    static bool is_frozen(ContextType, const ValueType &);
+    static bool is_schema_frozen(ContextType, ObjectType);
 };
 
 template<typename T>
@@ -154,10 +180,43 @@ Property Schema<T>::parse_property(ContextType ctx, ValueType attributes, std::s
     return prop;
 }
 
+template<typename T>
+void Schema<T>::parse_compound_indexes(ContextType ctx, ObjectType indexes_object, ObjectSchema &object_schema) {
+    uint32_t index_count = Object::validated_get_length(ctx, indexes_object);
+    for (uint32_t i = 0; i < index_count; i++) {
+        ObjectType index_object = Object::validated_get_array(ctx, indexes_object, i, "Each entry in 'indexes' must be an array of property names.");
+        uint32_t column_count = Object::validated_get_length(ctx, index_object);
+        if (!column_count) {
+            throw std::runtime_error("Compound index on '" + object_schema.name + "' must name at least one property");
+        }
+
+        Property *leading_property = nullptr;
+        for (uint32_t j = 0; j < column_count; j++) {
+            std::string property_name = Object::validated_get_string(ctx, index_object, j);
+            Property *property = object_schema.property_for_name(property_name);
+            if (!property) {
+                throw std::runtime_error("Missing compound index property '" + property_name + "' on '" + object_schema.name + "'");
+            }
+            if (!property->is_indexable()) {
+                throw std::runtime_error("Property '" + object_schema.name + "." + property_name + "' of type '" +
+                                         string_for_property_type(property->type) + "' cannot be part of an index");
+            }
+            if (!leading_property) {
+                leading_property = property;
+            }
+        }
+
+        // The storage engine only has single-column search indexes, so only the leading property is
+        // indexed. The trailing properties are validated but get no index of their own.
+        leading_property->is_indexed = true;
+    }
+}
+
 template<typename T>
 ObjectSchema Schema<T>::parse_object_schema(ContextType ctx, ObjectType object_schema_object, ObjectDefaultsMap &defaults, ConstructorMap &constructors) {
     static const String name_string = "name";
     static const String primary_string = "primaryKey";
+    static const String indexes_string = "indexes";
     static const String properties_string = "properties";
     static const String schema_string = "schema";
     
@@ -197,7 +256,12 @@ ObjectSchema Schema<T>::parse_object_schema(ContextType ctx, ObjectType object_s
         }
         property->is_primary = true;
     }
-    
+
+    ValueType indexes_value = Object::get_property(ctx, object_schema_object, indexes_string);
+    if (!Value::is_undefined(ctx, indexes_value)) {
+        parse_compound_indexes(ctx, Value::validated_to_array(ctx, indexes_value, "indexes"), object_schema);
+    }
+
     // Store prototype so that objects of this type will have their prototype set to this prototype object.
     if (Value::is_valid(object_constructor)) {
         constructors.emplace(object_schema.name, Protected<FunctionType>(ctx, object_constructor));
@@ -222,6 +286,96 @@ realm::Schema Schema<T>::parse_schema(ContextType ctx, ObjectType schema_object,
     return realm::Schema(schema);
 }
 
+template<typename T>
+std::shared_ptr<const typename Schema<T>::ParsedSchema> Schema<T>::parse_cached_schema(ContextType ctx, ObjectType schema_object) {
+    Protected<ObjectType> key(ctx, schema_object);
+    auto cached = cache().find(key);
+    if (cached != cache().end()) {
+        return cached->second;
+    }
+
+    auto parsed = std::make_shared<ParsedSchema>();
+    parsed->schema = parse_schema(ctx, schema_object, parsed->defaults, parsed->constructors);
+
+    if (is_schema_frozen(ctx, schema_object)) {
+        if (cache().size() >= max_cache_size) {
+            cache().clear();
+        }
+        cache().emplace(std::move(key), parsed);
+    }
+    return parsed;
+}
+
+template<typename T>
+void Schema<T>::clear_cache() {
+    cache().clear();
+}
+
+template<typename T>
+bool Schema<T>::is_frozen(ContextType ctx, const ValueType &value) {
+    static const String object_string = "Object";
+    static const String is_frozen_string = "isFrozen";
+
+    if (!Value::is_object(ctx, value)) {
+        return true;
+    }
+
+    ObjectType object_constructor = Value::validated_to_object(ctx, Object::get_global(ctx, object_string));
+    ValueType arguments[1] = {value};
+    return Value::to_boolean(ctx, Object::call_method(ctx, object_constructor, is_frozen_string, 1, arguments));
+}
+
+// Checks every object read by parse_object_schema(), which has already validated them.
+template<typename T>
+bool Schema<T>::is_schema_frozen(ContextType ctx, ObjectType schema_object) {
+    static const String indexes_string = "indexes";
+    static const String properties_string = "properties";
+    static const String schema_string = "schema";
+
+    if (!is_frozen(ctx, schema_object)) {
+        return false;
+    }
+
+    uint32_t length = Object::validated_get_length(ctx, schema_object);
+    for (uint32_t i = 0; i < length; i++) {
+        ObjectType object_schema_object = Object::validated_get_object(ctx, schema_object, i);
+        if (!is_frozen(ctx, object_schema_object)) {
+            return false;
+        }
+        if (Value::is_constructor(ctx, object_schema_object)) {
+            object_schema_object = Object::validated_get_object(ctx, object_schema_object, schema_string);
+            if (!is_frozen(ctx, object_schema_object)) {
+                return false;
+            }
+        }
+
+        ObjectType properties_object = Object::validated_get_object(ctx, object_schema_object, properties_string);
+        if (!is_frozen(ctx, properties_object)) {
+            return false;
+        }
+        for (auto &property_name : Object::get_property_names(ctx, properties_object)) {
+            if (!is_frozen(ctx, Object::get_property(ctx, properties_object, property_name))) {
+                return false;
+            }
+        }
+
+        ValueType indexes_value = Object::get_property(ctx, object_schema_object, indexes_string);
+        if (!Value::is_undefined(ctx, indexes_value)) {
+            ObjectType indexes_object = Value::validated_to_object(ctx, indexes_value);
+            if (!is_frozen(ctx, indexes_object)) {
+                return false;
+            }
+            uint32_t index_count = Object::validated_get_length(ctx, indexes_object);
+            for (uint32_t j = 0; j < index_count; j++) {
+                if (!is_frozen(ctx, Object::get_property(ctx, indexes_object, j))) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
 template<typename T>
 typename T::Object Schema<T>::object_for_schema(ContextType ctx, const realm::Schema &schema) {
     ObjectType object = Object::create_array(ctx);
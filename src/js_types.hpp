@@ -278,6 +278,9 @@ class Protected {
     struct Comparator {
         bool operator()(const Protected<ValueType>& a, const Protected<ValueType>& b) const;
     };
+    struct Hasher {
+        size_t operator()(const Protected<ValueType>& a) const;
+    };
 };
 
 template<typename T>
@@ -56,6 +56,11 @@ class Protected {
             return Nan::New(a.m_value)->StrictEquals(Nan::New(b.m_value));
         }
     };
+    struct Hasher {
+        size_t operator()(const Protected<MemberType>& a) const {
+            return Nan::New(a.m_value)->GetIdentityHash();
+        }
+    };
 };
 
 } // node
@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2016 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace realm {
+
+// Keeps the most recent latency samples of one stage of the notification pipeline.
+class LatencyHistogram {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    void record(Clock::duration duration) {
+        double ms = std::chrono::duration<double, std::milli>(duration).count();
+        if (m_samples.size() < max_samples) {
+            m_samples.push_back(ms);
+        }
+        else {
+            m_samples[m_count % max_samples] = ms;
+        }
+        ++m_count;
+    }
+
+    // The total number of samples recorded, including those no longer kept.
+    size_t count() const {
+        return m_count;
+    }
+
+    // Returns the given percentile (0-100) of the kept samples in milliseconds.
+    double percentile(double percent) const {
+        if (m_samples.empty()) {
+            return 0;
+        }
+
+        std::vector<double> sorted(m_samples);
+        size_t index = std::min(sorted.size() - 1, size_t(percent / 100 * sorted.size()));
+        std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+        return sorted[index];
+    }
+
+  private:
+    static const size_t max_samples = 1024;
+
+    std::vector<double> m_samples;
+    size_t m_count = 0;
+};
+
+// Records how long it takes one Realm to be notified of commits and to call its listeners.
+class NotificationStats {
+  public:
+    using Clock = LatencyHistogram::Clock;
+
+    // From a commit made by this process to the start of the notification run delivering it.
+    LatencyHistogram commit_to_notify;
+    // From the start of a notification run until all of its listeners were called.
+    LatencyHistogram notify;
+    // The time spent in each JS listener callback.
+    LatencyHistogram callback;
+
+    class CallbackTimer {
+      public:
+        CallbackTimer(NotificationStats &stats) : m_stats(stats), m_start(Clock::now()) {}
+        ~CallbackTimer() {
+            m_stats.callback.record(Clock::now() - m_start);
+        }
+
+      private:
+        NotificationStats &m_stats;
+        Clock::time_point m_start;
+    };
+
+    // The commit times of a path are only kept while a NotificationStats for it exists.
+    explicit NotificationStats(std::string path) : m_path(std::move(path)) {
+        std::lock_guard<std::mutex> lock(commit_mutex());
+        commit_times()[m_path].observers++;
+    }
+    ~NotificationStats() {
+        std::lock_guard<std::mutex> lock(commit_mutex());
+        auto commit = commit_times().find(m_path);
+        if (commit != commit_times().end() && --commit->second.observers == 0) {
+            commit_times().erase(commit);
+        }
+    }
+    NotificationStats(const NotificationStats &) = delete;
+    NotificationStats &operator=(const NotificationStats &) = delete;
+
+    static void did_commit(const std::string &path) {
+        std::lock_guard<std::mutex> lock(commit_mutex());
+        auto commit = commit_times().find(path);
+        if (commit != commit_times().end()) {
+            commit->second.time = Clock::now();
+        }
+    }
+
+    void will_notify() {
+        m_notify_start = Clock::now();
+
+        std::lock_guard<std::mutex> lock(commit_mutex());
+        auto commit = commit_times().find(m_path);
+        if (commit != commit_times().end() && commit->second.time > m_last_commit) {
+            m_last_commit = commit->second.time;
+            commit_to_notify.record(m_notify_start - m_last_commit);
+        }
+    }
+
+    void did_notify() {
+        if (m_notify_start != Clock::time_point()) {
+            notify.record(Clock::now() - m_notify_start);
+            m_notify_start = Clock::time_point();
+        }
+    }
+
+  private:
+    struct CommitTime {
+        Clock::time_point time;
+        size_t observers = 0;
+    };
+
+    const std::string m_path;
+    Clock::time_point m_notify_start;
+    Clock::time_point m_last_commit;
+
+    static std::mutex &commit_mutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+    static std::map<std::string, CommitTime> &commit_times() {
+        static std::map<std::string, CommitTime> times;
+        return times;
+    }
+};
+
+} // realm
@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2016 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+
+#include <realm/exceptions.hpp>
+#include <realm/group_shared.hpp>
+#include <realm/history.hpp>
+#include <realm/util/file.hpp>
+
+#if REALM_ENABLE_SYNC
+#include <realm/sync/history.hpp>
+#endif
+
+#include "shared_realm.hpp"
+
+namespace realm {
+
+// A session of its own on the file of a Realm, which does not need the Realm to be opened
+// first. It is used to decide whether to compact a file before opening it, and to report the
+// space used by Realms which are open.
+//
+// The session never upgrades the file format, since the dates in files from before file format
+// 5 are only converted when the Realm itself upgrades the file. Opening a file which has to be
+// upgraded throws FileFormatUpgradeRequired.
+class RealmFileSession {
+  public:
+    struct Stats {
+        size_t total_bytes;
+        size_t used_bytes;
+    };
+
+    explicit RealmFileSession(const Realm::Config &config) {
+        // The history has to match the one of the other sessions on the file.
+#if REALM_ENABLE_SYNC
+        if (config.sync_config) {
+            m_history = sync::make_sync_history(config.path);
+        }
+        else
+#endif
+        {
+            m_history = make_in_realm_history(config.path);
+        }
+
+        SharedGroupOptions options;
+        options.durability = config.in_memory ? SharedGroupOptions::Durability::MemOnly : SharedGroupOptions::Durability::Full;
+        options.encryption_key = config.encryption_key.empty() ? nullptr : config.encryption_key.data();
+        options.allow_file_format_upgrade = false;
+        m_shared_group.reset(new SharedGroup(*m_history, options));
+    }
+
+    static bool exists(const Realm::Config &config) {
+        return !config.in_memory && util::File::exists(config.path);
+    }
+
+    // The used bytes are those of the latest version, while the rest of the file is free space.
+    Stats stats() {
+        size_t free_bytes = 0, used_bytes = 0;
+        m_shared_group->get_stats(free_bytes, used_bytes);
+        return {free_bytes + used_bytes, used_bytes};
+    }
+
+    // Returns false without compacting if the file is open in any other session.
+    bool compact() {
+        return m_shared_group->compact();
+    }
+
+  private:
+    std::unique_ptr<Replication> m_history;
+    std::unique_ptr<SharedGroup> m_shared_group;
+};
+
+} // realm
@@ -0,0 +1,230 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2016 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "base64.hpp"
+#include "json.hpp"
+
+#include "object_schema.hpp"
+#include "property.hpp"
+#include "results.hpp"
+#include "shared_realm.hpp"
+#include "timestamp_format.hpp"
+
+namespace realm {
+
+// Writes the objects of a Results to a file as NDJSON or CSV, reading the values directly from
+// the table columns. Dates are written as ISO 8601 strings and binary data as base64, matching
+// what Realm.importJSON() reads.
+class ResultsExporter {
+  public:
+    enum class Format { NDJSON, CSV };
+
+    struct Options {
+        Format format = Format::NDJSON;
+        std::vector<std::string> projection;
+        // How many levels of linked objects are written as nested objects. Links beyond that
+        // are written as the primary key of the linked object, or null if it has none.
+        size_t link_depth = 0;
+    };
+
+    struct Stats {
+        size_t rows;
+        double seconds;
+    };
+
+    ResultsExporter(Results results, Options options) : m_results(std::move(results)), m_options(std::move(options)) {
+        auto &object_schema = m_results.get_object_schema();
+        if (m_options.projection.empty()) {
+            for (auto &property : object_schema.persisted_properties) {
+                m_properties.push_back(&property);
+            }
+            return;
+        }
+
+        for (auto &name : m_options.projection) {
+            const Property *property = object_schema.property_for_name(name);
+            if (!property) {
+                throw std::invalid_argument("Property '" + name + "' does not exist on '" + object_schema.name + "'.");
+            }
+            m_properties.push_back(property);
+        }
+    }
+
+    Stats write_to(const std::string &path) {
+        auto start = std::chrono::steady_clock::now();
+
+        // Rows are small, so let the stream collect them into large writes.
+        std::vector<char> buffer(1 << 20);
+        std::ofstream stream;
+        stream.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+        stream.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!stream.is_open()) {
+            throw std::runtime_error("Unable to open '" + path + "' for exporting.");
+        }
+
+        if (m_options.format == Format::CSV) {
+            for (size_t i = 0; i < m_properties.size(); ++i) {
+                stream << (i ? "," : "") << csv_escape(m_properties[i]->name);
+            }
+            stream << '\n';
+        }
+
+        // Rows deleted since the results were snapshotted are skipped and not counted.
+        size_t rows = 0;
+        size_t size = m_results.size();
+        for (size_t i = 0; i < size; ++i) {
+            RowExpr row = m_results.get(i);
+            if (!row.is_attached()) {
+                continue;
+            }
+            ++rows;
+
+            if (m_options.format == Format::NDJSON) {
+                stream << object_to_json(row, m_properties, 0).dump() << '\n';
+                continue;
+            }
+
+            for (size_t j = 0; j < m_properties.size(); ++j) {
+                if (j) {
+                    stream << ',';
+                }
+                nlohmann::json value = value_to_json(row, *m_properties[j], 0);
+                if (value.is_string()) {
+                    stream << csv_escape(value.get<std::string>());
+                }
+                else if (value.is_structured()) {
+                    stream << csv_escape(value.dump());
+                }
+                else if (!value.is_null()) {
+                    stream << value.dump();
+                }
+            }
+            stream << '\n';
+        }
+
+        stream.close();
+        if (stream.fail()) {
+            throw std::runtime_error("Unable to write to '" + path + "'.");
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return {rows, elapsed.count()};
+    }
+
+  private:
+    Results m_results;
+    Options m_options;
+    std::vector<const Property *> m_properties;
+
+    nlohmann::json object_to_json(RowExpr row, const std::vector<const Property *> &properties, size_t depth) {
+        nlohmann::json object = nlohmann::json::object();
+        for (auto property : properties) {
+            object[property->name] = value_to_json(row, *property, depth);
+        }
+        return object;
+    }
+
+    nlohmann::json linked_object_to_json(RowExpr row, const std::string &object_type, size_t depth) {
+        auto &object_schema = *m_results.get_realm()->schema().find(object_type);
+        if (depth < m_options.link_depth) {
+            std::vector<const Property *> properties;
+            for (auto &property : object_schema.persisted_properties) {
+                properties.push_back(&property);
+            }
+            return object_to_json(row, properties, depth + 1);
+        }
+
+        if (const Property *primary_key = object_schema.primary_key_property()) {
+            return value_to_json(row, *primary_key, depth);
+        }
+        return nullptr;
+    }
+
+    nlohmann::json value_to_json(RowExpr row, const Property &property, size_t depth) {
+        size_t column = property.table_column;
+        if (property.is_nullable && property.type != PropertyType::Object && row.is_null(column)) {
+            return nullptr;
+        }
+
+        switch (property.type) {
+            case PropertyType::Bool:
+                return row.get_bool(column);
+            case PropertyType::Int:
+                return row.get_int(column);
+            case PropertyType::Float:
+                return row.get_float(column);
+            case PropertyType::Double:
+                return row.get_double(column);
+            case PropertyType::String: {
+                StringData string = row.get_string(column);
+                return string.is_null() ? nlohmann::json() : nlohmann::json(std::string(string));
+            }
+            case PropertyType::Data: {
+                BinaryData data = row.get_binary(column);
+                if (data.is_null()) {
+                    return nullptr;
+                }
+                return base64_encode(reinterpret_cast<const unsigned char *>(data.data()), data.size());
+            }
+            case PropertyType::Date:
+                return format_timestamp(row.get_timestamp(column));
+            case PropertyType::Object: {
+                if (row.is_null_link(column)) {
+                    return nullptr;
+                }
+                auto target = row.get_table()->get_link_target(column);
+                return linked_object_to_json(target->get(row.get_link(column)), property.object_type, depth);
+            }
+            case PropertyType::Array: {
+                nlohmann::json array = nlohmann::json::array();
+                LinkViewRef link_view = row.get_linklist(column);
+                for (size_t i = 0; i < link_view->size(); ++i) {
+                    array.push_back(linked_object_to_json(link_view->get(i), property.object_type, depth));
+                }
+                return array;
+            }
+            default:
+                throw std::runtime_error("Property '" + property.name + "' can not be exported.");
+        }
+    }
+
+    static std::string csv_escape(const std::string &value) {
+        if (value.find_first_of(",\"\r\n") == std::string::npos) {
+            return value;
+        }
+
+        std::string escaped = "\"";
+        for (char c : value) {
+            if (c == '"') {
+                escaped += '"';
+            }
+            escaped += c;
+        }
+        return escaped + "\"";
+    }
+};
+
+} // realm
@@ -44,6 +44,7 @@ static const char * const RealmObjectTypesResults = "results";
 static const char * const RealmObjectTypesRealm = "realm";
 static const char * const RealmObjectTypesUser = "user";
 static const char * const RealmObjectTypesSession = "session";
+static const char * const RealmObjectTypesMigration = "migration";
 static const char * const RealmObjectTypesUndefined = "undefined";
 
 static RPCServer*& get_rpc_server(JSGlobalContextRef ctx) {
@@ -404,6 +405,12 @@ json RPCServer::serialize_json_value(JSValueRef js_value) {
             {"data", session_dict}
         };
     }
+    else if (jsc::Object::is_instance<js::MigrationClass<jsc::Types>>(m_context, js_object)) {
+        return {
+            {"type", RealmObjectTypesMigration},
+            {"id", store_object(js_object)},
+        };
+    }
     else if (jsc::Value::is_array(m_context, js_object)) {
         uint32_t length = jsc::Object::validated_get_length(m_context, js_object);
         std::vector<json> array;
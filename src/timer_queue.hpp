@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2016 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace realm {
+
+// Runs scheduled functions on a single background thread once their deadline has passed.
+// Functions which need to touch JS must forward to the JS thread, e.g. with an EventLoopDispatcher.
+class TimerQueue {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    static TimerQueue& shared() {
+        // Intentionally leaked so the timer thread never outlives the queue during process exit.
+        static TimerQueue *queue = new TimerQueue();
+        return *queue;
+    }
+
+    void schedule(Clock::time_point deadline, std::function<void()> function) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_thread_started) {
+            std::thread([this] { run(); }).detach();
+            m_thread_started = true;
+        }
+        m_timers.emplace(deadline, std::move(function));
+        lock.unlock();
+        m_condition.notify_one();
+    }
+
+  private:
+    void run() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            if (m_timers.empty()) {
+                m_condition.wait(lock);
+                continue;
+            }
+
+            auto next = m_timers.begin();
+            if (Clock::now() < next->first) {
+                m_condition.wait_until(lock, next->first);
+                continue;
+            }
+
+            auto function = std::move(next->second);
+            m_timers.erase(next);
+
+            lock.unlock();
+            function();
+            lock.lock();
+        }
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::multimap<Clock::time_point, std::function<void()>> m_timers;
+    bool m_thread_started = false;
+};
+
+} // realm
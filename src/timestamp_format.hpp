@@ -0,0 +1,73 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2016 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include <realm/timestamp.hpp>
+
+namespace realm {
+
+// Formats a timestamp as an ISO 8601 string in UTC with millisecond precision, like
+// Date.prototype.toISOString() does.
+inline std::string format_timestamp(Timestamp timestamp) {
+    int64_t milliseconds = timestamp.get_seconds() * 1000 + timestamp.get_nanoseconds() / 1000000;
+    int64_t days = milliseconds / 86400000;
+    int64_t remainder = milliseconds % 86400000;
+    if (remainder < 0) {
+        remainder += 86400000;
+        --days;
+    }
+
+    // Converts days since the epoch into a civil date.
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    unsigned day_of_era = (unsigned)(days - era * 146097);
+    unsigned year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    unsigned day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    unsigned month_index = (5 * day_of_year + 2) / 153;
+    unsigned day = day_of_year - (153 * month_index + 2) / 5 + 1;
+    unsigned month = month_index < 10 ? month_index + 3 : month_index - 9;
+    int64_t year = (int64_t)year_of_era + era * 400 + (month <= 2);
+
+    char string[32];
+    snprintf(string, sizeof(string), "%04lld-%02u-%02uT%02d:%02d:%02d.%03dZ", (long long)year, month, day,
+             int(remainder / 3600000), int(remainder / 60000 % 60), int(remainder / 1000 % 60), int(remainder % 1000));
+    return string;
+}
+
+// Converts milliseconds since the epoch, the time value of a JS Date, into a timestamp. Fractions
+// of a millisecond are kept, and values outside the range of a JS Date are rejected.
+inline Timestamp timestamp_from_milliseconds(double milliseconds) {
+    if (!(std::fabs(milliseconds) <= 8.64e15)) {
+        char string[32];
+        snprintf(string, sizeof(string), "%.17g", milliseconds);
+        throw std::invalid_argument(std::string("Can not convert ") + string + " milliseconds to a date.");
+    }
+
+    // The seconds and nanoseconds of a timestamp must have the same sign.
+    double seconds = std::trunc(milliseconds / 1000);
+    return Timestamp((int64_t)seconds, (int32_t)((milliseconds - seconds * 1000) * 1000000));
+}
+
+} // realm
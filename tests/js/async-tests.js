@@ -136,6 +136,92 @@ module.exports = {
         );
     },
 
+    testBeforeNotifyNotifications() {
+        var config = { schema: [schemas.TestObject] };
+        var events = [];
+        return createNotificationTest(
+            config,
+            (realm) => realm,
+            (realm, increment, resolve, reject, cleanup) => {
+                realm.addListener('beforenotify', (r, name) => events.push(name));
+                realm.addListener('change', (r, name) => {
+                    try {
+                        events.push(name);
+                        TestCase.assertArraysEqual(events, ['beforenotify', 'change']);
+                        events = [];
+                        increment();
+                    } catch (e) {
+                        reject(e);
+                        cleanup();
+                    }
+                });
+            },
+            undefined,
+            [[config, 'create', 'TestObject', [{doubleCol: 42}]]],
+            1
+        );
+    },
+
+    testSchemaNotifications() {
+        var config = { schema: [schemas.TestObject] };
+        var otherConfig = { schema: [schemas.TestObject, schemas.IntPrimary] };
+        return createNotificationTest(
+            config,
+            (realm) => realm,
+            (realm, increment, resolve, reject, cleanup) => realm.addListener('schema', (r, name) => {
+                try {
+                    TestCase.assertEqual(name, 'schema');
+                    TestCase.assertEqual(realm.schema.length, 2);
+                    increment();
+                } catch (e) {
+                    reject(e);
+                    cleanup();
+                }
+            }),
+            undefined,
+            [[otherConfig, 'create', 'IntPrimaryObject', [[0, '0']]]],
+            1
+        );
+    },
+
+    testObjectNotifications() {
+        var config = { schema: [schemas.IntPrimary] };
+        var expected = [
+            { deleted: false, changedProperties: ['valueCol'] },
+            { deleted: true, changedProperties: [] },
+        ];
+        return createNotificationTest(
+            config,
+            (realm) => {
+                let object;
+                realm.write(() => {
+                    object = realm.create('IntPrimaryObject', [0, '0']);
+                });
+                return object;
+            },
+            (object, increment, resolve, reject, cleanup) => {
+                var listener = (changedObject, changes) => {
+                    try {
+                        var notificationCount = increment();
+                        TestCase.assertTrue(changedObject === object);
+                        TestCase.assertEqual(JSON.stringify(changes), JSON.stringify(expected[notificationCount]));
+                    } catch (e) {
+                        reject(e);
+                        cleanup();
+                    }
+                };
+                object.addListener(listener);
+                return listener;
+            },
+            undefined,
+            [
+                [config, 'update', 'IntPrimaryObject', [[0, '1']]],
+                [config, 'delete', 'IntPrimaryObject', [0]]
+            ],
+            expected.length
+        );
+    },
+
     testResultsAddNotifications() {
         var config = { schema: [schemas.TestObject] };
         return createCollectionChangeTest(
@@ -153,6 +239,93 @@ module.exports = {
         );
     },
 
+    testResultsRangeNotifications() {
+        var config = { schema: [schemas.TestObject] };
+        var expected = [
+            { insertions: [], deletions: [], modifications: [], moves: [] },
+            { insertions: [[0, 1]], deletions: [], modifications: [], moves: [] },
+            { insertions: [[1, 3]], deletions: [], modifications: [], moves: [] },
+        ];
+        return createNotificationTest(
+            config,
+            (realm) => realm.objects('TestObject'),
+            (collection, increment, resolve, reject, cleanup) => {
+                collection.addListener((object, changes) => {
+                    try {
+                        var notificationCount = increment();
+                        TestCase.assertEqual(JSON.stringify(changes), JSON.stringify(expected[notificationCount]));
+                    } catch (e) {
+                        reject(e);
+                        cleanup();
+                    }
+                }, { ranges: true });
+            },
+            undefined,
+            [
+                [config, 'create', 'TestObject', [{ doubleCol: 1 }]],
+                [config, 'create', 'TestObject', [{ doubleCol: 2 }, { doubleCol: 3 }]]
+            ],
+            expected.length
+        );
+    },
+
+    testResultsDebouncedNotifications() {
+        var realm = new Realm({ schema: [schemas.TestObject] });
+        var objects = realm.objects('TestObject');
+
+        TestCase.assertThrows(() => objects.addListener(() => {}, { debounceMs: -1 }));
+        TestCase.assertThrows(() => objects.addListener(() => {}, { throttleMs: -1 }));
+        TestCase.assertThrows(() => objects.addListener(() => {}, { throttleMs: 10, debounceMs: 10 }));
+
+        // How many deliveries the two writes are merged into depends on timing, so only the merged
+        // contents are asserted: every insertion is reported exactly once and in order.
+        return new Promise((resolve, reject) => {
+            var insertions = [];
+            var calls = 0;
+            objects.addListener((collection, changes) => {
+                try {
+                    calls++;
+                    insertions = insertions.concat(changes.insertions);
+                    if (calls == 1) {
+                        realm.write(() => realm.create('TestObject', { doubleCol: 1 }));
+                        realm.write(() => realm.create('TestObject', { doubleCol: 2 }));
+                    }
+                    else if (collection.length == 2) {
+                        TestCase.assertArraysEqual(insertions, [0, 1]);
+                        TestCase.assertTrue(calls <= 3);
+                        objects.removeAllListeners();
+                        resolve();
+                    }
+                } catch (e) {
+                    objects.removeAllListeners();
+                    reject(e);
+                }
+            }, { debounceMs: 20 });
+        });
+    },
+
+    testResultsRemoveListenerByToken() {
+        var realm = new Realm({ schema: [schemas.TestObject] });
+        var objects = realm.objects('TestObject');
+        var first = 0, second = 0;
+        var wait = (ms) => new Promise((resolve) => setTimeout(resolve, ms));
+
+        var firstToken = objects.addListener(() => first++);
+        var secondToken = objects.addListener(() => second++);
+        TestCase.assertType(firstToken, 'number');
+        TestCase.assertNotEqual(firstToken, secondToken);
+
+        return wait(50).then(() => {
+            objects.removeListener(firstToken);
+            realm.write(() => realm.create('TestObject', { doubleCol: 1 }));
+            return wait(100);
+        }).then(() => {
+            TestCase.assertEqual(first, 1);
+            TestCase.assertEqual(second, 2);
+            objects.removeListener(secondToken);
+        });
+    },
+
     testResultsRemoveNotifications() {
         var config = { schema: [schemas.TestObject] };
         return createCollectionChangeTest(
@@ -356,5 +529,261 @@ module.exports = {
             ]
         );
     },
-};
 
+    testResultsEvaluateAsync() {
+        var realm = new Realm({ schema: [schemas.TestObject] });
+        realm.write(() => {
+            for (var i = 0; i < 10; i++) {
+                realm.create('TestObject', { doubleCol: i });
+            }
+        });
+
+        var results = realm.objects('TestObject').filtered('doubleCol >= 5');
+        return results.evaluateAsync().then((evaluated) => {
+            TestCase.assertTrue(evaluated === results);
+            TestCase.assertEqual(evaluated.length, 5);
+            return realm.objectsAsync('TestObject');
+        }).then((objects) => {
+            TestCase.assertTrue(objects instanceof Realm.Results);
+            TestCase.assertEqual(objects.length, 10);
+        });
+    },
+
+    testResultsCreateReadStream() {
+        var realm = new Realm({ schema: [schemas.PersonObject] });
+        realm.write(() => {
+            for (var i = 0; i < 25; i++) {
+                realm.create('PersonObject', { name: 'Person ' + i, age: i });
+            }
+        });
+
+        var objects = realm.objects('PersonObject').sorted('age');
+        var batches = [];
+        var lines = '';
+
+        return new Promise((resolve, reject) => {
+            objects.createReadStream({ batchSize: 10, projection: ['name'] })
+                .on('data', (batch) => batches.push(batch))
+                .on('error', reject)
+                .on('end', resolve);
+        }).then(() => {
+            TestCase.assertArraysEqual(batches.map((batch) => batch.length), [10, 10, 5]);
+            TestCase.assertEqual(batches[0][0].name, 'Person 0');
+            TestCase.assertEqual(batches[0][0].age, undefined);
+
+            return new Promise((resolve, reject) => {
+                objects.createReadStream({ format: 'ndjson' })
+                    .on('data', (chunk) => lines += chunk.toString())
+                    .on('error', reject)
+                    .on('end', resolve);
+            });
+        }).then(() => {
+            var rows = lines.trim().split('\n').map((line) => JSON.parse(line));
+            TestCase.assertEqual(rows.length, 25);
+            TestCase.assertEqual(rows[24].age, 24);
+        });
+    },
+
+    testResultsCreateReadStreamLinks() {
+        var DogSchema = { name: 'Dog', primaryKey: 'name', properties: { name: 'string' } };
+        var OwnerSchema = {
+            name: 'Owner',
+            properties: {
+                name: 'string',
+                dog: 'Dog',
+                dogs: { type: 'list', objectType: 'Dog' },
+            }
+        };
+        var realm = new Realm({ schema: [DogSchema, OwnerSchema] });
+        realm.write(() => {
+            var rex = realm.create('Dog', { name: 'Rex' });
+            realm.create('Owner', { name: 'Alice', dog: rex, dogs: [{ name: 'Fido' }, rex] });
+            realm.create('Owner', { name: 'Bob', dog: null, dogs: [] });
+        });
+
+        var objects = realm.objects('Owner');
+        [0, -1, 1.5, NaN, '10'].forEach((batchSize) => {
+            TestCase.assertThrows(() => objects.createReadStream({ batchSize: batchSize }));
+        });
+
+        var lines = '';
+        return new Promise((resolve, reject) => {
+            objects.createReadStream({ format: 'ndjson' })
+                .on('data', (chunk) => lines += chunk.toString())
+                .on('error', reject)
+                .on('end', resolve);
+        }).then(() => {
+            var rows = lines.trim().split('\n').map((line) => JSON.parse(line));
+            TestCase.assertEqual(rows.length, 2);
+            TestCase.assertEqual(rows[0].dog, 'Rex');
+            TestCase.assertArraysEqual(rows[0].dogs, ['Fido', 'Rex']);
+            TestCase.assertEqual(rows[1].dog, null);
+            TestCase.assertArraysEqual(rows[1].dogs, []);
+        });
+    },
+
+    testRealmExportTo() {
+        const fs = require('fs');
+        var realm = new Realm({ schema: [schemas.PersonObject, schemas.PersonList] });
+        realm.write(() => {
+            var list = realm.create('PersonList', { list: [] }).list;
+            for (var i = 0; i < 25; i++) {
+                list.push({ name: 'Person, "' + i + '"', age: i });
+            }
+        });
+
+        var ndjsonPath = Realm.defaultPath + '.ndjson';
+        var csvPath = Realm.defaultPath + '.csv';
+        var people = realm.objects('PersonObject').filtered('age >= 20').sorted('age');
+
+        return realm.exportTo(people, ndjsonPath, { projection: ['age', 'name'] }).then((stats) => {
+            TestCase.assertEqual(stats.rows, 5);
+            TestCase.assertTrue(stats.rowsPerSecond >= 0);
+
+            var rows = fs.readFileSync(ndjsonPath, 'utf8').trim().split('\n').map((line) => JSON.parse(line));
+            TestCase.assertEqual(rows.length, 5);
+            TestCase.assertEqual(rows[0].name, 'Person, "20"');
+            TestCase.assertEqual(rows[0].married, undefined);
+            TestCase.assertArraysEqual(Object.keys(rows[0]), ['age', 'name']);
+
+            return realm.exportTo('PersonObject', csvPath, { format: 'csv', background: true });
+        }).then((stats) => {
+            TestCase.assertEqual(stats.rows, 25);
+
+            var lines = fs.readFileSync(csvPath, 'utf8').trim().split('\n');
+            TestCase.assertEqual(lines.length, 26);
+            TestCase.assertEqual(lines[0], 'name,age,married');
+            TestCase.assertEqual(lines[1], '"Person, ""0""",0,false');
+
+            return realm.exportTo('PersonList', ndjsonPath, { linkDepth: 1 });
+        }).then(() => {
+            var list = JSON.parse(fs.readFileSync(ndjsonPath, 'utf8')).list;
+            TestCase.assertEqual(list.length, 25);
+            TestCase.assertEqual(list[3].age, 3);
+
+            return realm.exportTo('PersonList', ndjsonPath);
+        }).then(() => {
+            var list = JSON.parse(fs.readFileSync(ndjsonPath, 'utf8')).list;
+            TestCase.assertEqual(list[0], null);
+
+            // Objects deleted after the snapshot was taken are neither written nor counted.
+            var snapshot = realm.objects('PersonObject').snapshot();
+            realm.write(() => realm.delete(realm.objects('PersonObject').filtered('age < 10')));
+            return realm.exportTo(snapshot, ndjsonPath);
+        }).then((stats) => {
+            TestCase.assertEqual(stats.rows, 15);
+            TestCase.assertEqual(fs.readFileSync(ndjsonPath, 'utf8').trim().split('\n').length, 15);
+
+            return realm.exportTo('PersonObject', csvPath, { format: 'xml' }).then(() => {
+                throw new Error('The export should have failed');
+            }, () => {});
+        }).then(() => {
+            return realm.exportTo('PersonObject', csvPath, { projection: ['invalid'], background: true }).then(() => {
+                throw new Error('The export should have failed');
+            }, () => {});
+        });
+    },
+
+    testRealmWriteCopyTo() {
+        const fs = require('fs');
+        var realm = new Realm({ schema: [schemas.TestObject] });
+        realm.write(() => {
+            for (var i = 0; i < 100; i++) {
+                realm.create('TestObject', { doubleCol: i });
+            }
+        });
+
+        var copyPath = Realm.defaultPath + '.copy.realm';
+        var encryptedPath = Realm.defaultPath + '.encrypted.realm';
+        var key = new Int8Array(64);
+        key[0] = 1;
+
+        return realm.writeCopyTo(copyPath).then((stats) => {
+            TestCase.assertEqual(stats.bytes, fs.statSync(copyPath).size);
+            TestCase.assertEqual(new Realm({ path: copyPath, schema: [schemas.TestObject] }).objects('TestObject').length, 100);
+
+            return realm.writeCopyTo(encryptedPath, { encryptionKey: key, background: true });
+        }).then((stats) => {
+            TestCase.assertTrue(stats.bytes > 0);
+            var copy = new Realm({ path: encryptedPath, encryptionKey: key, schema: [schemas.TestObject] });
+            TestCase.assertEqual(copy.objects('TestObject').filtered('doubleCol >= 50').length, 50);
+            copy.close();
+
+            return realm.writeCopyTo(copyPath).then(() => {
+                throw new Error('Writing over an existing file should have failed');
+            }, () => {});
+        }).then(() => {
+            return realm.writeCopyTo(copyPath + '2', { compact: false }).then(() => {
+                throw new Error('Writing an uncompacted copy should have failed');
+            }, () => {});
+        });
+    },
+
+    testRealmOpen() {
+        var compactCalls = 0;
+        var config = {
+            schema: [schemas.TestObject],
+            shouldCompactOnLaunch: (totalBytes, usedBytes) => {
+                TestCase.assertTrue(usedBytes <= totalBytes);
+                compactCalls++;
+                return true;
+            },
+        };
+
+        return Realm.open(config).then((realm) => {
+            TestCase.assertTrue(realm instanceof Realm);
+            TestCase.assertEqual(compactCalls, 0);
+            realm.write(() => realm.create('TestObject', { doubleCol: 1 }));
+            realm.close();
+
+            return Realm.open(config);
+        }).then((realm) => {
+            TestCase.assertEqual(compactCalls, 1);
+            TestCase.assertEqual(realm.objects('TestObject').length, 1);
+            realm.close();
+
+            return Realm.open({ schema: [schemas.TestObject], schemaVersion: 1, migration: (oldRealm, newRealm) => {
+                TestCase.assertEqual(oldRealm.schemaVersion, 0);
+                newRealm.objects('TestObject')[0].doubleCol = 2;
+            }});
+        }).then((realm) => {
+            TestCase.assertEqual(realm.objects('TestObject')[0].doubleCol, 2);
+            realm.close();
+
+            return Realm.open({ schema: [schemas.BasicTypes] }).then(() => {
+                throw new Error('Opening with a changed schema and no new version should have failed');
+            }, () => {});
+        });
+    },
+
+    testRealmOpenUpgradesDates() {
+        Realm.copyBundledRealmFiles();
+
+        // The file is not measured before it has been upgraded, so its dates are still converted.
+        var compactCalls = 0;
+        var progress = [];
+        var config = {
+            path: 'dates-v3.realm',
+            schema: [schemas.DateObject],
+            shouldCompactOnLaunch: () => {
+                compactCalls++;
+                return true;
+            },
+            upgradeProgress: (converted, total) => progress.push([converted, total]),
+        };
+
+        return Realm.open(config).then((realm) => {
+            TestCase.assertEqual(compactCalls, 0);
+            TestCase.assertArraysEqual(progress[progress.length - 1], [4, 4]);
+            TestCase.assertEqual(realm.objects('Date')[0].currentDate.getTime(), 1462500087955);
+            TestCase.assertEqual(realm.objects('Date')[1].currentDate.getTime(), -10000);
+            realm.close();
+
+            return Realm.open(config);
+        }).then((realm) => {
+            TestCase.assertEqual(compactCalls, 1);
+            TestCase.assertEqual(realm.objects('Date')[0].currentDate.getTime(), 1462500087955);
+            realm.close();
+        });
+    },
+};
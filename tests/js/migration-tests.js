@@ -119,6 +119,169 @@ module.exports = {
         TestCase.assertEqual(objects[0].prop0, undefined);
     },
 
+    testMigrationWritesAndDeletes: function() {
+        var ListObject = {name: 'ListObject', properties: {list: {type: 'list', objectType: 'TestObject'}}};
+        var realm = new Realm({schema: [{name: 'TestObject', properties: {value: 'int'}}, ListObject]});
+        realm.write(function() {
+            realm.create('ListObject', {list: [{value: 1}, {value: 2}, {value: 3}, {value: 4}]});
+        });
+        realm.close();
+
+        realm = new Realm({
+            schema: [{name: 'TestObject', properties: {value: 'int', doubled: 'int'}}, ListObject],
+            schemaVersion: 1,
+            migration: function(oldRealm, newRealm) {
+                var objects = newRealm.objects('TestObject');
+                objects.forEach(function(object) {
+                    object.doubled = object.value * 2;
+                });
+
+                newRealm.create('TestObject', {value: 5, doubled: 10});
+                newRealm.objects('ListObject')[0].list.push(objects[4]);
+
+                newRealm.delete(objects.filtered('value == 1')[0]);
+                newRealm.delete(objects.filtered('value == 2').slice());
+                newRealm.delete(objects.filtered('value == 3'));
+                newRealm.delete(newRealm.objects('ListObject')[0].list.filtered('value == 4'));
+
+                TestCase.assertThrows(function() {
+                    newRealm.savepoint(function() {});
+                });
+                TestCase.assertThrows(function() {
+                    newRealm.truncate();
+                });
+            }
+        });
+
+        TestCase.assertArraysEqual(realm.objects('TestObject').sorted('value').map(function(object) {
+            return [object.value, object.doubled];
+        }), [[5, 10]]);
+        TestCase.assertEqual(realm.objects('ListObject')[0].list.length, 1);
+
+        var resets = 0;
+        realm.addListener('reset', function() {
+            resets++;
+        });
+        realm.write(function() {
+            realm.create('TestObject', {value: 6, doubled: 12});
+        });
+        TestCase.assertEqual(resets, 0);
+        TestCase.assertEqual(realm.objects('TestObject').length, 2);
+
+        realm.close();
+        realm = new Realm({
+            schema: [{name: 'TestObject', properties: {value: 'int', doubled: 'int'}}, ListObject],
+            schemaVersion: 2,
+            migration: function(oldRealm, newRealm) {
+                newRealm.deleteAll();
+            }
+        });
+        TestCase.assertEqual(realm.objects('TestObject').length, 0);
+        TestCase.assertEqual(realm.objects('ListObject').length, 0);
+    },
+
+    testNativeMigration: function() {
+        var realm = new Realm({schema: [{
+            name: 'TestObject',
+            properties: {
+                prop0: 'string',
+                prop1: 'int',
+                prop2: 'string',
+                prop3: 'double',
+            }
+        }]});
+        realm.write(function() {
+            for (var i = 0; i < 3; i++) {
+                realm.create('TestObject', ['value' + i, i, String(i * 10), i + 0.5]);
+            }
+        });
+        realm.close();
+
+        var completedMigration;
+        realm = new Realm({
+            schema: [{
+                name: 'TestObject',
+                properties: {
+                    renamed: 'string',
+                    prop1: 'string',
+                    prop2: 'int',
+                    copied: 'double',
+                    filled: {type: 'bool', optional: true},
+                }
+            }],
+            schemaVersion: 1,
+            migration: function(oldRealm, newRealm, migration) {
+                migration.renameProperty('TestObject', 'prop0', 'renamed');
+                migration.convertColumn('TestObject', 'prop1', 'int', 'string');
+                migration.convertColumn('TestObject', 'prop2', 'string', 'int');
+                migration.copyColumn('TestObject', 'prop3', 'copied');
+                migration.fillDefault('TestObject', 'filled', true);
+
+                TestCase.assertThrows(function() {
+                    migration.convertColumn('TestObject', 'prop1', 'double', 'string');
+                });
+                TestCase.assertThrows(function() {
+                    migration.copyColumn('TestObject', 'prop1', 'copied');
+                });
+                TestCase.assertTrue(migration instanceof Realm.Migration);
+                completedMigration = migration;
+            }
+        });
+
+        var objects = realm.objects('TestObject');
+        TestCase.assertEqual(objects.length, 3);
+        TestCase.assertEqual(objects[2].renamed, 'value2');
+        TestCase.assertEqual(objects[2].prop1, '2');
+        TestCase.assertEqual(objects[2].prop2, 20);
+        TestCase.assertEqual(objects[2].copied, 2.5);
+        TestCase.assertEqual(objects[2].filled, true);
+        TestCase.assertEqual(objects[2].prop0, undefined);
+
+        TestCase.assertThrows(function() {
+            completedMigration.fillDefault('TestObject', 'filled', null);
+        });
+    },
+
+    testNativeMigrationOutOfRange: function() {
+        var realm = new Realm({schema: [{name: 'TestObject', properties: {value: 'double'}}]});
+        realm.write(function() {
+            realm.create('TestObject', {value: 1e300});
+        });
+        realm.close();
+
+        TestCase.assertThrows(function() {
+            new Realm({
+                schema: [{name: 'TestObject', properties: {value: 'int'}}],
+                schemaVersion: 1,
+                migration: function(oldRealm, newRealm, migration) {
+                    migration.convertColumn('TestObject', 'value', 'double', 'int');
+                }
+            });
+        });
+    },
+
+    testNativeMigrationUnsupportedConversion: function() {
+        var realm = new Realm({schema: [{name: 'TestObject', properties: {value: 'double'}}]});
+        realm.write(function() {
+            realm.create('TestObject', {value: 1});
+        });
+        realm.close();
+
+        TestCase.assertThrows(function() {
+            new Realm({
+                schema: [{name: 'TestObject', properties: {value: 'bool'}}],
+                schemaVersion: 1,
+                migration: function(oldRealm, newRealm, migration) {
+                    migration.convertColumn('TestObject', 'value', 'double', 'bool');
+                }
+            });
+        });
+
+        realm = new Realm({schema: [{name: 'TestObject', properties: {value: 'double'}}]});
+        TestCase.assertEqual(realm.objects('TestObject')[0].value, 1);
+        realm.close();
+    },
+
     testMigrationSchema: function() {
         var realm = new Realm({schema: [{
             name: 'TestObject',
@@ -515,5 +515,44 @@ module.exports = {
         TestCase.assertEqual(realm.objects('Date')[1].currentDate.getTime(), -10000);
         TestCase.assertEqual(realm.objects('Date')[2].currentDate.getTime(), 1000000000000);
         TestCase.assertEqual(realm.objects('Date')[3].currentDate.getTime(), -1000000000000);
+    },
+
+    testDatesUpgradeProgress: function() {
+        Realm.copyBundledRealmFiles();
+
+        var progress = [];
+        var config = {path: 'dates-v3.realm', schema: [schemas.DateObject], upgradeProgress: function(converted, total) {
+            progress.push([converted, total]);
+        }};
+        var realm = new Realm(config);
+        TestCase.assertEqual(realm.objects('Date')[1].currentDate.getTime(), -10000);
+        TestCase.assertArraysEqual(progress[progress.length - 1], [4, 4]);
+        realm.close();
+
+        // the conversion only happens once
+        progress = [];
+        realm = new Realm(config);
+        TestCase.assertEqual(progress.length, 0);
+        TestCase.assertEqual(realm.objects('Date')[0].currentDate.getTime(), 1462500087955);
+    },
+
+    testDatesUpgradeWithCompactOnLaunch: function() {
+        Realm.copyBundledRealmFiles();
+
+        // Files which need to be upgraded are not measured, so that opening them converts the dates.
+        var compactCalls = 0;
+        var config = {path: 'dates-v3.realm', schema: [schemas.DateObject], shouldCompactOnLaunch: function() {
+            compactCalls++;
+            return true;
+        }};
+        var realm = new Realm(config);
+        TestCase.assertEqual(compactCalls, 0);
+        TestCase.assertEqual(realm.objects('Date')[0].currentDate.getTime(), 1462500087955);
+        TestCase.assertEqual(realm.objects('Date')[1].currentDate.getTime(), -10000);
+        realm.close();
+
+        realm = new Realm(config);
+        TestCase.assertEqual(compactCalls, 1);
+        TestCase.assertEqual(realm.objects('Date')[0].currentDate.getTime(), 1462500087955);
     }
 };
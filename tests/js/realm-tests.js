@@ -149,6 +149,69 @@ module.exports = {
         TestCase.assertEqual(realm.readOnly, true);
     },
 
+    testRealmConstructorInMemory: function() {
+        var realm = new Realm({path: 'memory.realm', inMemory: true, schema: [schemas.TestObject]});
+        TestCase.assertEqual(realm.inMemory, true);
+        realm.write(function() {
+            realm.create('TestObject', [1]);
+        });
+
+        var other = new Realm({path: 'memory.realm', durability: 'memory', schema: [schemas.TestObject]});
+        TestCase.assertEqual(other.objects('TestObject').length, 1);
+        realm.close();
+        other.close();
+
+        TestCase.assertEqual(new Realm({schema: [], durability: 'full'}).inMemory, false);
+        TestCase.assertThrows(function() {
+            new Realm({schema: [], durability: 'async'});
+        });
+        TestCase.assertThrows(function() {
+            new Realm({schema: [], durability: 'full', inMemory: true});
+        });
+    },
+
+    testRealmCompact: function() {
+        var realm = new Realm({schema: [schemas.TestObject]});
+        realm.write(function() {
+            for (var i = 0; i < 1000; i++) {
+                realm.create('TestObject', [i]);
+            }
+        });
+        realm.write(function() {
+            realm.deleteAll();
+        });
+
+        var stats = realm.getFileStats();
+        TestCase.assertTrue(stats.usedBytes > 0);
+        TestCase.assertEqual(stats.totalBytes, stats.usedBytes + stats.freeBytes);
+
+        TestCase.assertTrue(realm.compact());
+        TestCase.assertTrue(realm.getFileStats().totalBytes <= stats.totalBytes);
+
+        realm.write(function() {
+            TestCase.assertThrows(function() {
+                realm.compact();
+            });
+        });
+        realm.close();
+
+        var launchStats;
+        realm = new Realm({schema: [schemas.TestObject], shouldCompactOnLaunch: function(totalBytes, usedBytes) {
+            launchStats = [totalBytes, usedBytes];
+            return true;
+        }});
+        TestCase.assertTrue(launchStats[0] >= launchStats[1]);
+        TestCase.assertEqual(realm.objects('TestObject').length, 0);
+        realm.close();
+
+        TestCase.assertThrows(function() {
+            new Realm({schema: [schemas.TestObject], shouldCompactOnLaunch: function() {}});
+        });
+        TestCase.assertThrows(function() {
+            new Realm({readOnly: true, shouldCompactOnLaunch: function() { return false; }});
+        });
+    },
+
     testDefaultPath: function() {
         var defaultPath = Realm.defaultPath;
         var defaultRealm = new Realm({schema: []});
@@ -407,6 +470,22 @@ module.exports = {
             new Realm({schema: [IndexedSchema], path: '4.realm'});
         });
 
+        TestCase.assertThrows(function() {
+            IndexedSchema.properties = { intCol: {type: 'int', indexed: 'prefix'} }
+            new Realm({schema: [IndexedSchema], path: '6.realm'});
+        });
+
+        TestCase.assertThrows(function() {
+            IndexedSchema.properties = { stringCol: {type: 'string', indexed: 'fulltext'} }
+            new Realm({schema: [IndexedSchema], path: '7.realm'});
+        });
+
+        // The search index only serves equality, so there are no text index types.
+        TestCase.assertThrows(function() {
+            IndexedSchema.properties = { stringCol: {type: 'string', indexed: 'prefix'} }
+            new Realm({schema: [IndexedSchema], path: '8.realm'});
+        });
+
         // primary key
         IndexedSchema.properties = { boolCol: {type: 'bool', indexed: true} };
         IndexedSchema.primaryKey = 'boolCol';
@@ -415,6 +494,57 @@ module.exports = {
         new Realm({schema: [IndexedSchema], path: '5.realm'});
     },
 
+    testRealmWithCompoundIndexes: function() {
+        var MessageSchema = {
+            name: 'Message',
+            properties: {
+                chatId: 'string',
+                ts: 'date',
+                body: 'string',
+            },
+            indexes: [['chatId', 'ts']]
+        };
+
+        var realm = new Realm({schema: [MessageSchema]});
+        var properties = realm.schema[0].properties;
+        TestCase.assertEqual(properties.chatId.indexed, true);
+        TestCase.assertEqual(properties.ts.indexed, undefined);
+        TestCase.assertEqual(properties.body.indexed, undefined);
+
+        realm.write(function() {
+            for (var i = 0; i < 10; i++) {
+                realm.create('Message', {chatId: 'chat' + (i % 2), ts: new Date(i), body: 'body' + i});
+            }
+        });
+
+        var messages = realm.objects('Message').filtered('chatId == $0 AND ts > $1', 'chat0', new Date(3)).sorted('ts', true);
+        TestCase.assertEqual(messages.length, 3);
+        TestCase.assertEqual(messages[0].body, 'body8');
+        realm.close();
+
+        // Only the leading property of an entry is indexed.
+        MessageSchema.indexes = [['ts', 'chatId']];
+        var reversed = new Realm({schema: [MessageSchema], path: '4.realm'});
+        TestCase.assertEqual(reversed.schema[0].properties.ts.indexed, true);
+        TestCase.assertEqual(reversed.schema[0].properties.chatId.indexed, undefined);
+        reversed.close();
+
+        TestCase.assertThrows(function() {
+            MessageSchema.indexes = [['chatId', 'missing']];
+            new Realm({schema: [MessageSchema], path: '1.realm'});
+        });
+
+        TestCase.assertThrows(function() {
+            MessageSchema.indexes = [[]];
+            new Realm({schema: [MessageSchema], path: '2.realm'});
+        });
+
+        TestCase.assertThrows(function() {
+            MessageSchema.indexes = ['chatId'];
+            new Realm({schema: [MessageSchema], path: '3.realm'});
+        });
+    },
+
     testRealmCreateWithDefaults: function() {
         var realm = new Realm({schema: [schemas.DefaultValues, schemas.TestObject]});
 
@@ -465,6 +595,98 @@ module.exports = {
         realm.write(createAndTestObject);
     },
 
+    testRealmWithFrozenSchema: function() {
+        var objectSchema = Object.freeze({
+            name: 'IntObject',
+            primaryKey: 'id',
+            properties: Object.freeze({
+                id: 'int',
+                intCol: Object.freeze({type: 'int', default: 1}),
+            }),
+        });
+        var schema = Object.freeze([objectSchema]);
+
+        var realm1 = new Realm({schema: schema, path: '1.realm'});
+        var realm2 = new Realm({schema: schema, path: '2.realm'});
+        [realm1, realm2].forEach(function(realm) {
+            realm.write(function() {
+                TestCase.assertEqual(realm.create('IntObject', {id: 1}).intCol, 1);
+            });
+        });
+        realm2.close();
+
+        // Reopening the Realm reuses the parsed schema.
+        realm2 = new Realm({schema: schema, path: '2.realm'});
+        TestCase.assertEqual(realm2.schema[0].primaryKey, 'id');
+        TestCase.assertEqual(realm2.objects('IntObject')[0].intCol, 1);
+        realm2.write(function() {
+            TestCase.assertEqual(realm2.create('IntObject', {id: 2}).intCol, 1);
+        });
+
+        TestCase.assertThrows(function() {
+            new Realm({schema: [schemas.TestObject], path: '2.realm'});
+        });
+        realm2.close();
+
+        // The schema is still validated against the file, whose schema version may have changed.
+        new Realm({schema: schema, path: '2.realm', schemaVersion: 1}).close();
+        TestCase.assertThrows(function() {
+            new Realm({schema: schema, path: '2.realm'});
+        });
+    },
+
+    testRealmPool: function() {
+        var config = {schema: [schemas.TestObject]};
+        var pool = new Realm.Pool({config: config, max: 1});
+        TestCase.assertEqual(pool.metrics.misses, 1);
+        TestCase.assertEqual(pool.metrics.idle, 1);
+
+        var realm1 = pool.acquire();
+        var realm2 = pool.acquire();
+        TestCase.assertEqual(pool.metrics.hits, 1);
+        TestCase.assertEqual(pool.metrics.misses, 2);
+        TestCase.assertEqual(pool.metrics.acquired, 2);
+        TestCase.assertTrue(pool.metrics.averageOpenSeconds >= 0);
+
+        // An acquired Realm keeps its version while others write.
+        realm2.write(function() {
+            realm2.create('TestObject', {doubleCol: 1});
+        });
+        TestCase.assertEqual(realm1.objects('TestObject').length, 0);
+
+        pool.release(realm1);
+        pool.release(realm2);
+        TestCase.assertEqual(pool.metrics.idle, 1);
+        TestCase.assertEqual(pool.metrics.acquired, 0);
+        TestCase.assertThrows(function() {
+            realm2.objects('TestObject');
+        });
+
+        // The kept Realm is refreshed when acquired again.
+        var realm3 = pool.acquire();
+        TestCase.assertEqual(realm3, realm1);
+        TestCase.assertEqual(realm3.objects('TestObject').length, 1);
+        TestCase.assertThrows(function() {
+            pool.release(realm2);
+        });
+        TestCase.assertThrows(function() {
+            pool.release(new Realm(config));
+        });
+
+        pool.close();
+        TestCase.assertThrows(function() {
+            pool.acquire();
+        });
+        pool.release(realm3);
+        TestCase.assertThrows(function() {
+            realm3.objects('TestObject');
+        });
+
+        TestCase.assertThrows(function() {
+            new Realm.Pool({config: {schema: [schemas.TestObject], shouldCompactOnLaunch: function() { return true; }}});
+        });
+    },
+
     testRealmCreateWithConstructor: function() {
         var customCreated = 0;
 
@@ -621,6 +843,56 @@ module.exports = {
         TestCase.assertEqual(realm.objects('IntPrimaryObject').length, 0);
     },
 
+    testRealmTruncate: function() {
+        var realm = new Realm({schema: [schemas.TestObject, schemas.IntPrimary]});
+        var resets = 0;
+        realm.addListener('reset', function(sender, name) {
+            TestCase.assertEqual(name, 'reset');
+            TestCase.assertEqual(sender.objects('TestObject').length, 0);
+            resets++;
+        });
+
+        realm.write(function() {
+            for (var i = 0; i < 10; i++) {
+                realm.create('TestObject', {doubleCol: i});
+            }
+            realm.create('IntPrimaryObject', {primaryCol: 2, valueCol: 'value'});
+        });
+
+        TestCase.assertThrows(function() {
+            realm.truncate();
+        }, 'can only truncate in a write transaction');
+
+        realm.write(function() {
+            realm.truncate({types: ['TestObject']});
+            TestCase.assertEqual(resets, 0);
+        });
+        TestCase.assertEqual(resets, 1);
+        TestCase.assertEqual(realm.objects('TestObject').length, 0);
+        TestCase.assertEqual(realm.objects('IntPrimaryObject').length, 1);
+
+        TestCase.assertThrows(function() {
+            realm.write(function() {
+                realm.truncate();
+                throw new Error('cancelled');
+            });
+        });
+        TestCase.assertEqual(resets, 1);
+        TestCase.assertEqual(realm.objects('IntPrimaryObject').length, 1);
+
+        realm.write(function() {
+            realm.truncate({compact: true});
+        });
+        TestCase.assertEqual(resets, 2);
+        TestCase.assertEqual(realm.objects('IntPrimaryObject').length, 0);
+
+        realm.write(function() {
+            TestCase.assertThrows(function() {
+                realm.truncate({types: ['NoSuchObject']});
+            });
+        });
+    },
+
     testRealmObjects: function() {
         var realm = new Realm({schema: [schemas.PersonObject, schemas.DefaultValues, schemas.TestObject]});
 
@@ -778,6 +1050,16 @@ module.exports = {
             realm.addListener('invalid', function() {});
         });
 
+        // Removing the listeners of one event leaves the other events' listeners in place.
+        realm.addListener('beforenotify', function() {});
+        realm.addListener('change', secondNotification);
+        realm.removeAllListeners('beforenotify');
+        realm.write(function() {});
+        TestCase.assertEqual(secondNotificationCount, 2);
+        realm.removeAllListeners('change');
+        realm.write(function() {});
+        TestCase.assertEqual(secondNotificationCount, 2);
+
         realm.addListener('change', function() {
             throw new Error('error');
         });
@@ -787,6 +1069,235 @@ module.exports = {
         });
     },
 
+    testRealmImportJSON: function() {
+        var realm = new Realm({schema: [schemas.TestObject, schemas.AllTypes, schemas.DefaultValues, schemas.DateObject]});
+        var toBuffer = function(string) {
+            var bytes = new Uint8Array(string.length);
+            for (var i = 0; i < string.length; i++) {
+                bytes[i] = string.charCodeAt(i);
+            }
+            return bytes.buffer;
+        };
+
+        var records = [1, 2, 3, 4, 5].map(function(index) {
+            return {
+                primaryCol: String(index),
+                boolCol: index % 2 == 0,
+                intCol: index,
+                floatCol: index / 2,
+                doubleCol: index / 4,
+                stringCol: index == 2 ? 'a "quoted" }, {\\ ]' : 'string' + index,
+                dateCol: index == 1 ? '2017-01-01T00:00:00.500Z' : index * 1000,
+                dataCol: 'AQID',
+                objectCol: {doubleCol: index},
+                arrayCol: [{doubleCol: index}, {doubleCol: -index}],
+            };
+        });
+
+        var progress = [];
+        var count = Realm.importJSON(realm, 'AllTypesObject', toBuffer(JSON.stringify(records)), {
+            batchSize: 2,
+            progress: function(imported) {
+                progress.push(imported);
+            },
+        });
+        TestCase.assertEqual(count, 5);
+        TestCase.assertArraysEqual(progress, [2, 4, 5]);
+
+        var objects = realm.objects('AllTypesObject');
+        TestCase.assertEqual(objects.length, 5);
+        TestCase.assertEqual(objects[0].dateCol.getTime(), Date.UTC(2017, 0, 1, 0, 0, 0, 500));
+        TestCase.assertEqual(objects[1].dateCol.getTime(), 2000);
+        TestCase.assertEqual(objects[1].stringCol, 'a "quoted" }, {\\ ]');
+        TestCase.assertArraysEqual(new Uint8Array(objects[2].dataCol), [1, 2, 3]);
+        TestCase.assertEqual(objects[3].objectCol.doubleCol, 4);
+        TestCase.assertEqual(objects[4].arrayCol[1].doubleCol, -5);
+        TestCase.assertEqual(realm.objects('TestObject').length, 15);
+
+        // Records are imported with the defaults of the schema.
+        Realm.importJSON(realm, 'DefaultValuesObject', toBuffer('{"intCol": 2}\n\n{}\n'), {format: 'ndjson'});
+        var defaults = realm.objects('DefaultValuesObject');
+        TestCase.assertEqual(defaults.length, 2);
+        TestCase.assertEqual(defaults[0].intCol, 2);
+        TestCase.assertEqual(defaults[1].intCol, -1);
+        TestCase.assertEqual(defaults[1].stringCol, 'defaultString');
+        TestCase.assertEqual(defaults[1].dateCol.getTime(), 1);
+        TestCase.assertEqual(defaults[1].arrayCol[0].doubleCol, 2);
+
+        // A failing batch is rolled back, while earlier batches remain.
+        TestCase.assertThrows(function() {
+            Realm.importJSON(realm, 'TestObject', toBuffer('[{"doubleCol": 1}, {"doubleCol": 2}, {"doubleCol": "invalid"}]'), {batchSize: 2});
+        });
+        TestCase.assertEqual(realm.objects('TestObject').length, 21);
+
+        TestCase.assertThrows(function() {
+            Realm.importJSON(realm, 'TestObject', toBuffer('{"doubleCol": 1}'));
+        });
+        TestCase.assertEqual(Realm.importJSON(realm, 'TestObject', toBuffer(' [ ] ')), 0);
+        TestCase.assertThrows(function() {
+            Realm.importJSON(realm, 'TestObject', toBuffer('[{"doubleCol": 1}] []'));
+        });
+        TestCase.assertThrows(function() {
+            Realm.importJSON(realm, 'TestObject', toBuffer('[{"doubleCol": 1},'));
+        });
+        TestCase.assertThrows(function() {
+            Realm.importJSON(realm, 'TestObject', toBuffer('[{"doubleCol": 1},]'));
+        });
+        TestCase.assertEqual(realm.objects('TestObject').length, 21);
+        TestCase.assertThrows(function() {
+            realm.write(function() {
+                Realm.importJSON(realm, 'TestObject', toBuffer('[]'));
+            });
+        });
+
+        // Dates before the epoch keep their milliseconds, and numbers a Date can not hold are rejected.
+        Realm.importJSON(realm, 'Date', toBuffer('[{"currentDate": -1500}, {"currentDate": 8.64e15}]'));
+        TestCase.assertEqual(realm.objects('Date')[0].currentDate.getTime(), -1500);
+        TestCase.assertEqual(realm.objects('Date')[1].currentDate.getTime(), 8.64e15);
+        try {
+            Realm.importJSON(realm, 'Date', toBuffer('[{"currentDate": 0}, {"currentDate": 1e300}]'));
+            TestCase.assertTrue(false, 'Expected the out of range date to be rejected');
+        }
+        catch (e) {
+            TestCase.assertTrue(e.message.indexOf('record 2') != -1, e.message);
+        }
+        TestCase.assertEqual(realm.objects('Date').length, 2);
+    },
+
+    testRealmSavepoint: function() {
+        var realm = new Realm({schema: [schemas.IntPrimary, schemas.LinkTypes, schemas.TestObject]});
+        TestCase.assertThrows(function() {
+            realm.savepoint(function() {});
+        });
+
+        realm.write(function() {
+            var existing = realm.create('IntPrimaryObject', {primaryCol: 1, valueCol: 'one'});
+
+            TestCase.assertEqual(realm.savepoint(function() {
+                realm.create('IntPrimaryObject', {primaryCol: 2, valueCol: 'two'});
+                return 'saved';
+            }), 'saved');
+
+            [3, 1, 4].forEach(function(primaryCol) {
+                try {
+                    realm.savepoint(function() {
+                        existing.valueCol = 'changed';
+                        realm.create('LinkTypesObject', {objectCol: {doubleCol: 1}, arrayCol: [{doubleCol: 2}]});
+                        realm.create('IntPrimaryObject', {primaryCol: primaryCol, valueCol: 'new'});
+                        existing.valueCol = 'one';
+                    });
+                }
+                catch (e) {
+                    // The duplicate primary key is skipped.
+                }
+            });
+
+            TestCase.assertEqual(existing.valueCol, 'one');
+            TestCase.assertEqual(realm.objects('LinkTypesObject').length, 2);
+            TestCase.assertEqual(realm.objects('TestObject').length, 4);
+        });
+
+        TestCase.assertArraysEqual(realm.objects('IntPrimaryObject').map(function(object) {
+            return object.primaryCol;
+        }), [1, 2, 3, 4]);
+
+        // Changes which can not be undone are refused, and the write transaction goes on.
+        var object = realm.objects('LinkTypesObject')[0];
+        realm.write(function() {
+            var existing = realm.objectForPrimaryKey('IntPrimaryObject', 1);
+
+            TestCase.assertThrows(function() {
+                realm.savepoint(function() {
+                    realm.create('TestObject', {doubleCol: 3});
+                    object.arrayCol.push({doubleCol: 3});
+                });
+            });
+            TestCase.assertThrows(function() {
+                realm.savepoint(function() {
+                    realm.delete(existing);
+                });
+            });
+            TestCase.assertThrows(function() {
+                realm.savepoint(function() {
+                    realm.deleteAll();
+                });
+            });
+
+            TestCase.assertThrows(function() {
+                realm.savepoint(function() {
+                    realm.create('IntPrimaryObject', {primaryCol: 1, valueCol: 'updated'}, true);
+                    realm.delete(realm.create('TestObject', {doubleCol: 5}));
+                    throw new Error('rollback');
+                });
+            });
+            TestCase.assertEqual(existing.valueCol, 'one');
+
+            realm.create('TestObject', {doubleCol: 4});
+        });
+        TestCase.assertEqual(object.arrayCol.length, 1);
+        TestCase.assertEqual(realm.objects('IntPrimaryObject').length, 4);
+        TestCase.assertEqual(realm.objects('TestObject').length, 5);
+    },
+
+    testRealmQueueWrite: function() {
+        var realm = new Realm({schema: [schemas.TestObject]});
+        TestCase.assertThrows(function() {
+            realm.queueWrite(function() {
+                realm.create('TestObject', {doubleCol: 1});
+            });
+        });
+        TestCase.assertEqual(realm.objects('TestObject').length, 0);
+    },
+
+    testRealmQueueWriteGroupCommit: function() {
+        var realm = new Realm({schema: [schemas.TestObject], groupCommitMs: 20, groupCommitMax: 10});
+        TestCase.assertEqual(realm.groupCommitMs, 20);
+        TestCase.assertEqual(realm.groupCommitMax, 10);
+
+        // The settings belong to the Realm object, not to the file.
+        var other = new Realm({schema: [schemas.TestObject]});
+        TestCase.assertEqual(other.groupCommitMs, 0);
+        TestCase.assertEqual(other.groupCommitMax, 0);
+        TestCase.assertEqual(realm.groupCommitMs, 20);
+
+        var writes = [1, 2, 3].map(function(value) {
+            return realm.queueWrite(function() {
+                if (value == 2) {
+                    throw new Error('invalid');
+                }
+                realm.create('TestObject', {doubleCol: value});
+                return value;
+            }).catch(function(error) {
+                return error.message;
+            });
+        });
+
+        // The blocks have not been run yet.
+        TestCase.assertEqual(realm.objects('TestObject').length, 0);
+
+        return Promise.all(writes).then(function(results) {
+            TestCase.assertArraysEqual(results, [1, 'invalid', 3]);
+            TestCase.assertArraysEqual(realm.objects('TestObject').map(function(object) {
+                return object.doubleCol;
+            }), [1, 3]);
+        });
+    },
+
+    testNotificationStats: function() {
+        var realm = new Realm({schema: []});
+        realm.addListener('change', function() {});
+        realm.write(function() {});
+
+        var stats = realm.getNotificationStats();
+        ['commitToNotify', 'notify', 'callback'].forEach(function(stage) {
+            TestCase.assertType(stats[stage].count, 'number');
+            TestCase.assertType(stats[stage].p50, 'number');
+            TestCase.assertType(stats[stage].p99, 'number');
+        });
+        TestCase.assertEqual(stats.callback.count, 1);
+        TestCase.assertTrue(stats.callback.p50 <= stats.callback.p99);
+    },
+
     testSchema: function() {
         var originalSchema = [schemas.TestObject, schemas.BasicTypes, schemas.NullableBasicTypes, schemas.IndexedTypes, schemas.IntPrimary, 
             schemas.PersonObject, schemas.LinkTypes];